@@ -52,6 +52,11 @@ Settings::Settings(QWidget* parent)
     utils::load_key(json, m_ui->hideMouse, "hideMouse");
     utils::load_key(json, m_ui->inputDevice, "inputDevice");
 
+    // Same rate the overlay publishes at
+    connect(&m_stats_timer, SIGNAL(timeout()), this, SLOT(on_stats()));
+    m_stats_timer.start(250);
+    on_stats();
+
     // set window size
     this->resize(size().width() * 0.8, size().height() * 0.7);
 }
@@ -85,3 +90,25 @@ void Settings::on_hideMouse() {
 void Settings::on_inputDevice(const QString& text) {
     json["inputDevice"] = text.toStdString();
 }
+
+void Settings::on_stats() {
+    stats_channel::payload stats{};
+    if (!m_stats.attach() || !m_stats.read(stats)) {
+        m_stats_version = 0;
+        m_ui->apm->setText("-");
+        m_ui->presses->setText("-");
+        m_ui->speed->setText("-");
+        return;
+    }
+
+    const auto& version = m_stats.version();
+    if (version == m_stats_version) {
+        return;
+    }
+    m_stats_version = version;
+
+    // The minute window already counts a minute's worth of presses
+    m_ui->apm->setNum(static_cast<int>(stats.apm.presses(apm_window::minute)));
+    m_ui->presses->setText(QString::number(stats.apm.totals[apm_snapshot::total_row]));
+    m_ui->speed->setText(QString("%1 px/s").arg(qRound(stats.motion.max_speed)));
+}
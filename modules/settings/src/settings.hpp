@@ -22,7 +22,10 @@
 #include "thirdparty/json.hpp"
 #include "ui_settings.h"
 
+#include <vnepogodin/stats_channel.hpp>
+
 #include <QSettings>
+#include <QTimer>
 #include <QWidget>
 
 namespace Ui {
@@ -48,10 +51,17 @@ class Settings final : public QWidget {
 
     void on_inputDevice(const QString&);
 
+    void on_stats();
+
  private:
     QSettings* m_settings;
     Ui::Settings* m_ui;
 
+    /* Live stats from a running overlay */
+    StatsReader m_stats;
+    QTimer m_stats_timer;
+    std::uint64_t m_stats_version{};
+
     nlohmann::json json;
 };
 }  // namespace vnepogodin
@@ -0,0 +1,136 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef HISTORY_INDEX_HPP
+#define HISTORY_INDEX_HPP
+
+#include <vnepogodin/key_layout.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vnepogodin {
+namespace session_log {
+    struct block_view;
+}  // namespace session_log
+
+/**
+ * Per-day, per-game rollups of the overlay's session logs.
+ *
+ * Log files are mapped and only the bytes appended since the last
+ * refresh() are parsed, queries then only touch the rollups. Logs the
+ * overlay rotated away are picked up too: their sidecar index gives the
+ * press counts of keyboard-only blocks, so only blocks with clicks or
+ * crossing midnight are read record by record, compressed logs are only
+ * inflated for those. Days are counted in UTC from the Unix epoch.
+ */
+class HistoryIndex final {
+ public:
+    static constexpr std::size_t minutes_per_day = 24 * 60;
+    using game_id_t                              = std::uint16_t;
+    static constexpr game_id_t any_game          = 0xFFFF;
+
+    struct rollup {
+        std::array<std::uint64_t, layout::key_count> presses{};
+        /* Mouse presses in each minute of the day */
+        std::array<std::uint32_t, minutes_per_day> clicks{};
+    };
+
+    HistoryIndex() = default;
+    /**
+     * @param log_path is the overlay's active log, see session_log::default_path().
+     */
+    explicit HistoryIndex(std::filesystem::path log_path) : m_log_path(std::move(log_path)) { }
+
+    /**
+     * Picks up what was written to the logs since the last call. Rotated
+     * logs are read once, what was read from the active log before it got
+     * rotated isn't read again.
+     */
+    void refresh();
+
+    /* Today, in index days */
+    static std::int32_t today() noexcept;
+
+    /**
+     * @return any_game if the game never showed up in the logs.
+     */
+    game_id_t find_game(const std::string_view& name) const noexcept;
+
+    /**
+     * Most pressed keys over the inclusive day range, busiest first.
+     * @return pairs of layout::keys position and press count.
+     */
+    std::vector<std::pair<std::size_t, std::uint64_t>> top_keys(const std::int32_t& first_day, const std::int32_t& last_day,
+        const game_id_t& game = any_game, const std::size_t& count = 5) const;
+
+    /**
+     * Distribution of clicks per minute over the inclusive day range.
+     * Minutes without clicks are left out, bin i counts the minutes with
+     * [i * bin_width, (i + 1) * bin_width) clicks, the last bin takes the rest.
+     */
+    std::vector<std::uint32_t> clicks_per_minute(const std::int32_t& first_day, const std::int32_t& last_day,
+        const game_id_t& game = any_game, const std::uint32_t& bin_width = 10, const std::size_t& bin_count = 30) const;
+
+    inline const std::vector<std::string>& games() const noexcept { return m_games; }
+
+ private:
+    struct source {
+        /* Uncompressed name, the file may have gained the compressed suffix since */
+        std::filesystem::path path;
+        /* Bytes already folded into the rollups, uncompressed */
+        std::size_t offset{};
+        /* Rotated and read to the end */
+        bool done{};
+    };
+
+    std::filesystem::path m_log_path;
+    /* Rotated logs oldest first, then the active log */
+    std::vector<source> m_sources;
+    std::vector<std::string> m_games;
+    std::map<std::pair<std::int32_t, game_id_t>, rollup> m_rollups;
+
+    game_id_t game_id(const std::string_view& name);
+    /* Adds new rotated logs and forgets deleted ones, what was read from them stays in the rollups */
+    void discover();
+    /* @return false if the file shrank below what was already read */
+    bool scan(source& src);
+    void parse(const char* data, const std::size_t& size, source& src);
+    /* Parses the blocks starting at offsets only */
+    void parse_blocks(const char* data, const std::size_t& size, const std::vector<std::uint64_t>& offsets);
+    void add_block(const session_log::block_view& block);
+    /**
+     * Folds the entries of a closed log's index into the rollups and moves
+     * src past the chunks they cover.
+     * @return offsets of the blocks the index can't answer.
+     */
+    std::vector<std::uint64_t> fold_index(const std::filesystem::path& index_path, const std::size_t& log_size, source& src);
+
+    template <class Proc>
+    void for_each_rollup(const std::int32_t& first_day, const std::int32_t& last_day, const game_id_t& game, Proc&& proc) const;
+};
+}  // namespace vnepogodin
+
+#endif  // HISTORY_INDEX_HPP
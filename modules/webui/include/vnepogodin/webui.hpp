@@ -36,11 +36,10 @@ class Webui : public QWidget {
     explicit Webui(QWidget* parent = nullptr);
     virtual ~Webui();
 
-    void paintLoop();
     void show();
 
  private:
-    const int refresh_rate = 500;  // Frequency in hertz
+    static constexpr int poll_interval_ms = 250;
     JsInterface* m_jsinterface;
 
     std::unique_ptr<QWebChannel> m_channel;
@@ -48,6 +47,8 @@ class Webui : public QWidget {
     std::unique_ptr<QWebEngineProfile> m_profile;
     std::unique_ptr<QWebEnginePage> m_page;
     std::unique_ptr<QWebEngineView> m_view;
+
+    void pollStats();
 };
 
 #endif  // WEBUI_HPP
@@ -40,43 +40,51 @@ function create_pie_most_pressed(ctx, dict, qwan = 5) {
   return new Chart(ctx, config);
 }
 
-function update_pie_most_pressed(chart, dict, qwan = 5) {
-  const labels = Object.keys(dict).slice(0, qwan);
-  const values = Object.values(dict).slice(0, qwan);
-  chart.data.labels = labels;
-  chart.data.datasets.forEach((dataset) => { dataset.data = values; });
-  chart.update();
-}
+function update_pie_most_pressed(chart, names, counts, qwan = 5) {
+  // Pick the top entries without building intermediate objects.
+  const top = [];
+  for (let i = 0; i < counts.length; ++i) {
+    if (counts[i] <= 0) {
+      continue;
+    }
+    let pos = top.length;
+    while (pos > 0 && counts[top[pos - 1]] < counts[i]) {
+      --pos;
+    }
+    if (pos < qwan) {
+      top.splice(pos, 0, i);
+      top.length = Math.min(top.length, qwan);
+    }
+  }
+
+  const labels = chart.data.labels;
+  const values = chart.data.datasets[0].data;
+  let changed = labels.length !== top.length;
+  labels.length = top.length;
+  values.length = top.length;
+  for (let i = 0; i < top.length; ++i) {
+    if (labels[i] !== names[top[i]] || values[i] !== counts[top[i]]) {
+      labels[i] = names[top[i]];
+      values[i] = counts[top[i]];
+      changed = true;
+    }
+  }
 
-function create_bar_mouse_clicked(ctx, lrdata = [[0] * 5, [0] * 5], qwan = 5) {
-  window.lrdata = lrdata;
-  const date = new Date();
-  const times = [];
-  for (let i = 0; i < qwan; ++i) {
-    times.unshift(`${String(date.getHours())}:${String(date.getMinutes())}:${String(date.getSeconds())}`);
-    date.setTime(date - 1000);
+  if (changed) {
+    chart.update('none');
   }
+}
 
+function create_bar_mouse_clicked(ctx) {
   const config = {
     type: 'bar',
     data: {
-      labels: times,
+      labels: [],
       datasets: [{
-        label: 'Клики левой кнопки мыши',
+        label: 'Минуты с таким числом кликов',
         backgroundColor: 'rgb(255, 99, 132)',
         borderColor: 'rgb(255, 99, 132)',
-        data: lrdata[0],
-        pointRadius: 10,
-        pointHoverRadius: 15,
-        showLine: false
-      }, {
-        label: 'Клики правой кнопки мыши',
-        backgroundColor: 'rgb(255, 255, 132)',
-        borderColor: 'rgb(255, 255, 132)',
-        data: lrdata[1],
-        pointRadius: 10,
-        pointHoverRadius: 15,
-        showLine: false
+        data: []
       }],
     },
     options: {
@@ -90,13 +98,33 @@ function create_bar_mouse_clicked(ctx, lrdata = [[0] * 5, [0] * 5], qwan = 5) {
   return new Chart(ctx, config);
 }
 
-function update_bar_mouse_clicked(chart, newdata, qwan = 5) {
-  const times = chart.data.labels;
-  const date = new Date();
-  times.push(`${String(date.getHours())}:${String(date.getMinutes())}:${String(date.getSeconds())}`);
-  times = times.slice(1, qwan + 1);
-  chart.data.labels = times;
-  window.lrdata = newdata;
-  Object.keys(chart.data.datasets[0]).forEach((dataset) => { dataset.data = [1, 2, 3]; });
-  chart.update();
-}
\ No newline at end of file
+function update_bar_mouse_clicked(chart, bins, bin_width) {
+  // Bin i holds the minutes with [i * bin_width, (i + 1) * bin_width) clicks, the last one the rest.
+  chart.data.labels = bins.map((_, i) => (i + 1 < bins.length) ? `${i * bin_width}-${(i + 1) * bin_width - 1}` : `${i * bin_width}+`);
+  chart.data.datasets[0].data = bins;
+  chart.update('none');
+}
+
+function draw_heatmap(canvas, grid) {
+  if (!grid.cells || grid.cells.length !== grid.cols * grid.rows) {
+    return;
+  }
+
+  // One pixel per cell, the browser scales the canvas to the desktop's aspect ratio.
+  canvas.width = grid.cols;
+  canvas.height = grid.rows;
+  canvas.style.aspectRatio = `${grid.width} / ${grid.height}`;
+
+  // Dwell times span orders of magnitude, log scale keeps the paths visible.
+  const peak = Math.log1p(Math.max(...grid.cells));
+  const ctx = canvas.getContext('2d');
+  const image = ctx.createImageData(grid.cols, grid.rows);
+  for (let i = 0; i < grid.cells.length; ++i) {
+    const heat = (peak > 0) ? Math.log1p(grid.cells[i]) / peak : 0;
+    image.data[i * 4] = Math.round(255 * Math.min(1, heat * 2));
+    image.data[i * 4 + 1] = Math.round(255 * Math.max(0, heat * 2 - 1));
+    image.data[i * 4 + 2] = Math.round(64 * (1 - heat));
+    image.data[i * 4 + 3] = (grid.cells[i] > 0) ? 255 : 0;
+  }
+  ctx.putImageData(image, 0, 0);
+}
@@ -1,2 +1,24 @@
 const ctx = document.getElementById('root').getContext('2d');
-var chart = create_pie_most_pressed(ctx, { a_button: 0, ctrl_button: 0, d_button: 0, e_button: 0, q_button: 0, s_button: 0, shift_button: 0, space_button: 0, w_button: 0 });
\ No newline at end of file
+var chart = create_pie_most_pressed(ctx, { a_button: 0, ctrl_button: 0, d_button: 0, e_button: 0, q_button: 0, s_button: 0, shift_button: 0, space_button: 0, w_button: 0 });
+
+// Set up once, the host pushes new counts through keys_changed.
+window.webChannel = new QWebChannel(qt.webChannelTransport, (channel) => {
+  const cpp = channel.objects.JsInterface;
+  const names = cpp.key_names;
+
+  cpp.keys_changed.connect((counts) => { update_pie_most_pressed(chart, names, counts); });
+  cpp.request_update();
+
+  // Clicks per minute over the last week, the logger writes blocks at least every 30 s.
+  const clicks = create_bar_mouse_clicked(document.getElementById('clicks').getContext('2d'));
+  const bin_width = 10;
+  const refresh_clicks = () => { cpp.clicks_per_minute('', 7, bin_width, (bins) => { update_bar_mouse_clicked(clicks, bins, bin_width); }); };
+  refresh_clicks();
+  setInterval(refresh_clicks, 60000);
+
+  // The overlay saves its heatmap once a minute.
+  const heatmap = document.getElementById('heatmap');
+  const refresh_heatmap = () => { cpp.heatmap((grid) => { draw_heatmap(heatmap, grid); }); };
+  refresh_heatmap();
+  setInterval(refresh_heatmap, 60000);
+});
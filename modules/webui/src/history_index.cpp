@@ -0,0 +1,339 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/history_index.hpp>
+#include <vnepogodin/session_log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+using namespace vnepogodin;
+
+namespace {
+static constexpr std::int64_t ms_per_minute = 60 * 1000;
+static constexpr std::int64_t ms_per_day    = HistoryIndex::minutes_per_day * ms_per_minute;
+
+/* Floor division, timestamps before the epoch still land on the right day */
+constexpr std::int64_t floor_div(const std::int64_t& value, const std::int64_t& divisor) noexcept {
+    return (value >= 0) ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+/* qCompress() prefixes its output with the uncompressed size, big-endian */
+std::size_t uncompressed_size(const QByteArray& head) noexcept {
+    std::size_t result = 0;
+    for (int i = 0; i < 4 && i < head.size(); ++i) {
+        result = (result << 8U) | static_cast<std::uint8_t>(head[i]);
+    }
+    return result;
+}
+}  // namespace
+
+std::int32_t HistoryIndex::today() noexcept {
+    const auto& now = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<std::int32_t>(floor_div(std::chrono::duration_cast<std::chrono::milliseconds>(now).count(), ms_per_day));
+}
+
+void HistoryIndex::refresh() {
+    discover();
+    for (auto& src : m_sources) {
+        // Replaced without a rotation, e.g. deleted by hand, read it from the start.
+        if (!scan(src)) {
+            src.offset = 0;
+            scan(src);
+        }
+    }
+}
+
+void HistoryIndex::discover() {
+    std::vector<source> sources;
+    // The first new log after the known ones is the one that was active during the last refresh.
+    auto former_active = std::numeric_limits<std::size_t>::max();
+    for (auto path : session_log::rotated_files(m_log_path)) {
+        if (path.extension() == session_log::compressed_suffix) {
+            path.replace_extension();
+        }
+
+        const auto& known = std::find_if(m_sources.begin(), m_sources.end(), [&path](const auto& src) { return src.path == path; });
+        if (known != m_sources.end()) {
+            sources.push_back(std::move(*known));
+            former_active = std::numeric_limits<std::size_t>::max();
+            continue;
+        }
+        if (former_active == std::numeric_limits<std::size_t>::max()) {
+            former_active = sources.size();
+        }
+        sources.push_back({std::move(path), 0});
+    }
+
+    // Rotated logs are named after the time they were rotated at, so the
+    // active log ends up right after the logs rotated before it. What was
+    // read from it stays read.
+    auto active = m_sources.empty() ? source{m_log_path, 0} : std::move(m_sources.back());
+    if (former_active < sources.size()) {
+        sources[former_active].offset = std::exchange(active.offset, 0);
+    }
+    sources.push_back(std::move(active));
+    m_sources = std::move(sources);
+}
+
+bool HistoryIndex::scan(source& src) {
+    // Rotated logs never change.
+    if (src.done) {
+        return true;
+    }
+
+    std::error_code ec;
+    auto packed_path = src.path;
+    packed_path += session_log::compressed_suffix;
+    if (std::filesystem::exists(packed_path, ec)) {
+        QFile file(QString::fromStdString(packed_path.string()));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return true;
+        }
+        src.done = true;
+
+        const auto& size = uncompressed_size(file.peek(4));
+        std::vector<std::uint64_t> pending;
+        if (src.offset == 0) {
+            pending = fold_index(session_log::index_path(packed_path), size, src);
+        }
+        if (pending.empty() && src.offset >= size) {
+            return true;
+        }
+
+        const QByteArray& data = qUncompress(file.readAll());
+        if (!data.isEmpty()) {
+            parse_blocks(data.constData(), static_cast<std::size_t>(data.size()), pending);
+            parse(data.constData(), static_cast<std::size_t>(data.size()), src);
+        }
+        return true;
+    }
+
+    QFile file(QString::fromStdString(src.path.string()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Gone, e.g. dropped by retention, anything read from it stays in the rollups.
+        return true;
+    }
+
+    const auto& size = static_cast<std::size_t>(file.size());
+    if (size < src.offset) {
+        return false;
+    }
+    // Only the active log still grows, the others are read once.
+    const bool& rotated = src.path != m_log_path;
+    src.done            = rotated;
+
+    std::vector<std::uint64_t> pending;
+    if (rotated && src.offset == 0) {
+        pending = fold_index(session_log::index_path(src.path), size, src);
+    }
+    if (pending.empty() && size == src.offset) {
+        return true;
+    }
+
+    auto* data = file.map(0, file.size());
+    if (data == nullptr) {
+        return true;
+    }
+    parse_blocks(reinterpret_cast<const char*>(data), size, pending);
+    parse(reinterpret_cast<const char*>(data), size, src);
+    file.unmap(data);
+    return true;
+}
+
+std::vector<std::uint64_t> HistoryIndex::fold_index(const std::filesystem::path& index_path, const std::size_t& log_size, source& src) {
+    static_assert(layout::key_count <= session_log::index_key_slots, "index entries don't count every key");
+
+    std::vector<std::pair<session_log::index_entry, std::string>> entries;
+    session_log::index_reader in(index_path);
+    session_log::index_entry entry{};
+    std::string name;
+    while (in.next(entry, name)) {
+        entries.emplace_back(entry, name);
+    }
+    // An index that doesn't fit the log belongs to some other file, the records are the truth then.
+    if (entries.empty() || entries.back().first.offset + entries.back().first.size > log_size) {
+        return {};
+    }
+
+    std::vector<std::uint64_t> pending;
+    for (const auto& [chunk, game] : entries) {
+        if (chunk.type != session_log::chunk_type::block) {
+            continue;
+        }
+
+        // Clicks are binned by minute and presses by day, only the records know either.
+        const auto& day     = floor_div(chunk.first_time, ms_per_day);
+        bool clicks         = false;
+        for (std::size_t i = 0; i < layout::key_count; ++i) {
+            clicks = clicks || (layout::keys[i].source == layout::device::mouse && chunk.presses[i] > 0);
+        }
+        if (clicks || floor_div(chunk.last_time, ms_per_day) != day) {
+            pending.push_back(chunk.offset);
+            continue;
+        }
+
+        auto& current = m_rollups[{static_cast<std::int32_t>(day), game_id(game)}];
+        for (std::size_t i = 0; i < layout::key_count; ++i) {
+            current.presses[i] += chunk.presses[i];
+        }
+    }
+
+    src.offset = entries.back().first.offset + entries.back().first.size;
+    return pending;
+}
+
+void HistoryIndex::parse_blocks(const char* data, const std::size_t& size, const std::vector<std::uint64_t>& offsets) {
+    session_log::buffer_reader reader(data, size);
+    session_log::block_view block{};
+    session_log::segment_view segment{};
+    for (const auto& offset : offsets) {
+        reader.seek(offset);
+        if (reader.next(block, segment) == session_log::chunk_type::block) {
+            add_block(block);
+        }
+    }
+}
+
+void HistoryIndex::parse(const char* data, const std::size_t& size, source& src) {
+    session_log::buffer_reader reader(data, size);
+    reader.seek(src.offset);
+
+    session_log::block_view block{};
+    session_log::segment_view segment{};
+    session_log::chunk_type type{};
+    while ((type = reader.next(block, segment)) != session_log::chunk_type::none) {
+        if (type == session_log::chunk_type::block) {
+            add_block(block);
+        }
+    }
+
+    src.offset = reader.valid() ? reader.position() : size;
+}
+
+void HistoryIndex::add_block(const session_log::block_view& block) {
+    const auto& game  = game_id(block.name);
+    std::int64_t time = block.base_time;
+    rollup* current   = nullptr;
+    std::int64_t day  = 0;
+    for (std::size_t i = 0; i < block.count; ++i) {
+        time += block.delta_at(i);
+
+        const auto& key = block.key_at(i);
+        if (key >= layout::key_count || (block.type_at(i) != EVENT_KEY_PRESSED && block.type_at(i) != EVENT_MOUSE_PRESSED)) {
+            continue;
+        }
+
+        // Records are ordered, so the rollup only changes at midnight.
+        if (current == nullptr || floor_div(time, ms_per_day) != day) {
+            day     = floor_div(time, ms_per_day);
+            current = &m_rollups[{static_cast<std::int32_t>(day), game}];
+        }
+
+        ++current->presses[key];
+        if (layout::keys[key].source == layout::device::mouse) {
+            ++current->clicks[static_cast<std::size_t>(floor_div(time - day * ms_per_day, ms_per_minute))];
+        }
+    }
+}
+
+HistoryIndex::game_id_t HistoryIndex::game_id(const std::string_view& name) {
+    if (const auto& id = find_game(name); id != any_game) {
+        return id;
+    }
+    m_games.emplace_back(name);
+    return static_cast<game_id_t>(m_games.size() - 1);
+}
+
+HistoryIndex::game_id_t HistoryIndex::find_game(const std::string_view& name) const noexcept {
+    const auto& it = std::find(m_games.begin(), m_games.end(), name);
+    return (it != m_games.end()) ? static_cast<game_id_t>(it - m_games.begin()) : any_game;
+}
+
+template <class Proc>
+void HistoryIndex::for_each_rollup(const std::int32_t& first_day, const std::int32_t& last_day, const game_id_t& game, Proc&& proc) const {
+    for (auto it = m_rollups.lower_bound({first_day, 0}); it != m_rollups.end() && it->first.first <= last_day; ++it) {
+        if (game == any_game || it->first.second == game) {
+            proc(it->second);
+        }
+    }
+}
+
+std::vector<std::pair<std::size_t, std::uint64_t>> HistoryIndex::top_keys(const std::int32_t& first_day, const std::int32_t& last_day,
+    const game_id_t& game, const std::size_t& count) const {
+    std::array<std::uint64_t, layout::key_count> presses{};
+    for_each_rollup(first_day, last_day, game, [&presses](const rollup& day) {
+        for (std::size_t i = 0; i < presses.size(); ++i) {
+            presses[i] += day.presses[i];
+        }
+    });
+
+    std::vector<std::pair<std::size_t, std::uint64_t>> result;
+    for (std::size_t i = 0; i < presses.size(); ++i) {
+        if (presses[i] > 0) {
+            result.emplace_back(i, presses[i]);
+        }
+    }
+
+    const auto& middle = result.begin() + static_cast<std::ptrdiff_t>(std::min(count, result.size()));
+    std::partial_sort(result.begin(), middle, result.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    result.erase(middle, result.end());
+    return result;
+}
+
+std::vector<std::uint32_t> HistoryIndex::clicks_per_minute(const std::int32_t& first_day, const std::int32_t& last_day,
+    const game_id_t& game, const std::uint32_t& bin_width, const std::size_t& bin_count) const {
+    std::vector<std::uint32_t> result(bin_count);
+    if (bin_count == 0 || bin_width == 0) {
+        return result;
+    }
+
+    // Per-game rollups of one day share minutes, so sum them before binning.
+    std::array<std::uint32_t, minutes_per_day> clicks{};
+    std::int32_t day = first_day - 1;
+    const auto& flush_day = [&] {
+        for (const auto& minute : clicks) {
+            if (minute > 0) {
+                ++result[std::min<std::size_t>(minute / bin_width, bin_count - 1)];
+            }
+        }
+        clicks.fill(0);
+    };
+
+    for (auto it = m_rollups.lower_bound({first_day, 0}); it != m_rollups.end() && it->first.first <= last_day; ++it) {
+        if (game != any_game && it->first.second != game) {
+            continue;
+        }
+        if (it->first.first != day) {
+            flush_day();
+            day = it->first.first;
+        }
+        for (std::size_t i = 0; i < minutes_per_day; ++i) {
+            clicks[i] += it->second.clicks[i];
+        }
+    }
+    flush_day();
+    return result;
+}
@@ -16,63 +16,131 @@
 // with this program; if not, write to the Free Software Foundation, Inc.,
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
+#include <vnepogodin/heatmap_file.hpp>
+#include <vnepogodin/history_index.hpp>
+#include <vnepogodin/session_log.hpp>
+#include <vnepogodin/stats_channel.hpp>
 #include <vnepogodin/webui.hpp>
 
-#ifdef _WIN32
-#include <Windows.h>
-#endif
+#include <algorithm>
+#include <utility>
 
-#include <QFile>
+#include <QStringList>
 #include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
 #include <QWidget>
-#include <iostream>
-
-#ifdef _WIN32
-static HANDLE pipe = nullptr;
-#endif
 
 class JsInterface : public QObject {
     Q_OBJECT
+    /// names of the tracked keyboard keys, in the order of keys_changed counts
+    Q_PROPERTY(QStringList key_names READ key_names CONSTANT)
  public:
+    QStringList key_names() const {
+        QStringList result;
+        for (const auto& key : vnepogodin::layout::keys) {
+            if (key.source == vnepogodin::layout::device::keyboard) {
+                result << QString::fromUtf8(key.name.data(), static_cast<int>(key.name.size()));
+            }
+        }
+        return result;
+    }
 
-    /// get keys
-    Q_INVOKABLE QString get_keys() const {
-#ifdef _WIN32
-        if (pipe != INVALID_HANDLE_VALUE) {
-            // The read operation will block until there is data to read
-            wchar_t buffer[1000];
-            DWORD numBytesRead = 0;
-            BOOL result        = ReadFile(
-                pipe,
-                buffer,                 // the data from the pipe will be put here
-                999 * sizeof(wchar_t),  // number of bytes allocated
-                &numBytesRead,          // this will store number of bytes actually read
-                NULL                    // not using overlapped IO
-            );
-
-            if (result) {
-                buffer[numBytesRead / sizeof(wchar_t)] = '\0';  // null terminate the string
-                std::string res(std::begin(buffer), std::end(buffer));
-                return res.data();
+    /// re-sends the current counts, called once the page is ready
+    Q_INVOKABLE void request_update() {
+        m_last_version = 0;
+        m_last_totals  = {};
+        poll();
+    }
+
+    /// most pressed keys over the last days, game is empty for all games
+    Q_INVOKABLE QVariantMap top_keys(const QString& game, int days, int count = 5) {
+        const auto& [first_day, game_id] = history_range(game, days);
+
+        QStringList names;
+        QVariantList counts;
+        if (days > 0 && (game.isEmpty() || game_id != vnepogodin::HistoryIndex::any_game)) {
+            for (const auto& [key, presses] : m_history.top_keys(first_day, vnepogodin::HistoryIndex::today(), game_id, static_cast<std::size_t>(std::max(count, 0)))) {
+                const auto& name = vnepogodin::layout::keys[key].name;
+                names << QString::fromUtf8(name.data(), static_cast<int>(name.size()));
+                counts << QVariant::fromValue(static_cast<qulonglong>(presses));
             }
         }
+        return {{QStringLiteral("names"), names}, {QStringLiteral("counts"), counts}};
+    }
+
+    /// minutes binned by their click count over the last days
+    Q_INVOKABLE QVariantList clicks_per_minute(const QString& game, int days, int bin_width = 10) {
+        const auto& [first_day, game_id] = history_range(game, days);
 
-        return "{ \"a_button\": 0, \"ctrl_button\": 0, \"d_button\": 0, \"e_button\": 0, \"q_button\": 0, \"s_button\": 0, \"shift_button\": 0, \"space_button\": 0, \"w_button\": 0 }";
-#else
-        return "{ \"a_button\": 89, \"ctrl_button\": 72, \"d_button\": 5, \"e_button\": 2, \"q_button\": 2, \"s_button\": 4, \"shift_button\": 300, \"space_button\": 20, \"w_button\": 135 }";
-#endif
+        QVariantList bins;
+        if (days > 0 && bin_width > 0 && (game.isEmpty() || game_id != vnepogodin::HistoryIndex::any_game)) {
+            for (const auto& minutes : m_history.clicks_per_minute(first_day, vnepogodin::HistoryIndex::today(), game_id, static_cast<std::uint32_t>(bin_width))) {
+                bins << minutes;
+            }
+        }
+        return bins;
     }
-};
 
-#include "webui.moc"
+    /// cursor dwell time in milliseconds, row-major cells over the recorded desktop
+    Q_INVOKABLE QVariantMap heatmap() {
+        vnepogodin::heatmap_file::file_header header{};
+        vnepogodin::heatmap_file::grid grid;
+        if (!vnepogodin::heatmap_file::read(vnepogodin::heatmap_file::default_path(), header, grid)) {
+            return {};
+        }
 
-static QString qWebChannelJs() {
-    QFile file(QStringLiteral(":/res/thirdparty/qwebchannel.js"));
-    file.open(QIODevice::ReadOnly);
+        QVariantList cells;
+        cells.reserve(static_cast<int>(grid.size()));
+        for (const auto& dwell : grid) {
+            cells << dwell;
+        }
+        return {{QStringLiteral("cols"), header.cols}, {QStringLiteral("rows"), header.rows},
+            {QStringLiteral("width"), header.desktop.width}, {QStringLiteral("height"), header.desktop.height},
+            {QStringLiteral("cells"), cells}};
+    }
 
-    QTextStream in(&file);
-    return in.readAll();
-}
+    /// emits keys_changed if the overlay published new totals
+    void poll() {
+        if (!m_stats.attach() || m_stats.version() == m_last_version) {
+            return;
+        }
+        m_last_version = m_stats.version();
+
+        vnepogodin::stats_channel::payload stats{};
+        if (!m_stats.read(stats) || stats.apm.totals == m_last_totals) {
+            return;
+        }
+        m_last_totals = stats.apm.totals;
+
+        QVariantList counts;
+        for (std::size_t i = 0; i < vnepogodin::layout::key_count; ++i) {
+            if (vnepogodin::layout::keys[i].source == vnepogodin::layout::device::keyboard) {
+                counts << QVariant::fromValue(static_cast<qulonglong>(m_last_totals[i]));
+            }
+        }
+        emit keys_changed(counts);
+    }
+
+ signals:
+    /// presses since the overlay started, one per key_names entry
+    void keys_changed(const QVariantList& counts);
+
+ private:
+    vnepogodin::StatsReader m_stats;
+    vnepogodin::HistoryIndex m_history{vnepogodin::session_log::default_path()};
+    std::uint64_t m_last_version{};
+    decltype(vnepogodin::apm_snapshot::totals) m_last_totals{};
+
+    /* Picks up new log data, then maps the query to index terms */
+    std::pair<std::int32_t, vnepogodin::HistoryIndex::game_id_t> history_range(const QString& game, const int& days) {
+        m_history.refresh();
+        const auto& game_id = game.isEmpty() ? vnepogodin::HistoryIndex::any_game : m_history.find_game(game.toStdString());
+        return {vnepogodin::HistoryIndex::today() - days + 1, game_id};
+    }
+};
+
+#include "webui.moc"
 
 Webui::Webui(QWidget* parent) : QWidget(parent) {
     WebUiHandler::registerUrlScheme();
@@ -95,41 +163,19 @@ Webui::Webui(QWidget* parent) : QWidget(parent) {
     this->m_view->setContextMenuPolicy(Qt::NoContextMenu);
     this->m_view->resize(500, 600);
 
-#ifdef _WIN32
-    pipe = CreateFileW(
-        L"\\\\.\\pipe\\GOATTech",
-        GENERIC_READ,  // only need read access
-        FILE_SHARE_READ | FILE_SHARE_WRITE,
-        NULL,
-        OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL,
-        NULL);
-#endif
-
+    // The page sets up its channel once and listens to keys_changed, polling the
+    // shared memory segment here costs no syscalls.
     QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, QOverload<>::of(&Webui::paintLoop));
-    timer->start(std::chrono::milliseconds(50 * refresh_rate));
+    connect(timer, &QTimer::timeout, this, &Webui::pollStats);
+    timer->start(poll_interval_ms);
 }
 
 Webui::~Webui() {
-#ifdef _WIN32
-    CloseHandle(pipe);
-#endif
     delete this->m_jsinterface;
 }
 
-void Webui::paintLoop() {
-    this->m_view->page()->runJavaScript(qWebChannelJs());
-
-    QString code2 = QStringLiteral(
-        R"DELIM(
-        window.webChannel = new QWebChannel(qt.webChannelTransport, function(channel) {
-        const cpp = channel.objects.JsInterface;
-
-        cpp.get_keys().then((data) => { update_pie_most_pressed(chart, JSON.parse(data)); });
-    });
-    )DELIM");
-    this->m_view->page()->runJavaScript(code2);
+void Webui::pollStats() {
+    this->m_jsinterface->poll();
 }
 
 void Webui::show() {
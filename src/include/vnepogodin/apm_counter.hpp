@@ -0,0 +1,106 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef APM_COUNTER_HPP
+#define APM_COUNTER_HPP
+
+#include <vnepogodin/key_layout.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace vnepogodin {
+enum class apm_window : std::uint8_t {
+    second,
+    ten_seconds,
+    minute
+};
+
+/* Press counts over the rolling windows, plain data so it can be copied anywhere */
+struct apm_snapshot {
+    static constexpr std::size_t window_count = 3;
+    /* One row per layout::keys entry, the last row counts every press */
+    static constexpr std::size_t row_count = layout::key_count + 1;
+    static constexpr std::size_t total_row = layout::key_count;
+
+    std::array<std::array<std::uint32_t, row_count>, window_count> counts{};
+    /* Presses since start */
+    std::array<std::uint64_t, row_count> totals{};
+
+    inline std::uint32_t presses(const apm_window& window, const std::size_t& row = total_row) const noexcept {
+        return counts[static_cast<std::size_t>(window)][row];
+    }
+
+    /* Presses scaled to a minute */
+    float per_minute(const apm_window& window, const std::size_t& row = total_row) const noexcept;
+};
+static_assert(std::is_trivially_copyable<apm_snapshot>::value, "apm_snapshot must stay memcpy-able");
+
+/**
+ * Rolling 1 s / 10 s / 60 s press counters.
+ *
+ * Time is cut into 100 ms buckets kept in a ring covering the longest
+ * window; each bucket remembers its tick, so stale buckets are skipped
+ * without the writer having to clear them while idle. add() is called from
+ * the hook thread only and never allocates, snapshot() may run on any
+ * thread and is exact up to presses landing while it sums.
+ */
+class ApmCounter final {
+ public:
+    static constexpr std::int64_t tick_ms     = 100;
+    static constexpr std::size_t bucket_count = 600;
+    /* Length of each apm_window in ticks */
+    static constexpr std::array<std::int64_t, apm_snapshot::window_count> window_ticks = {10, 100, 600};
+
+    ApmCounter() = default;
+
+    /**
+     * Counts a press.
+     * @param key is the position in layout::keys, npos only counts towards the total.
+     * @param time_ms is an event_clock timestamp in milliseconds.
+     */
+    void add(const layout::key_index_t& key, const std::int64_t& time_ms) noexcept;
+    void add(const layout::key_index_t& key) noexcept;
+
+    apm_snapshot snapshot(const std::int64_t& time_ms) const noexcept;
+    apm_snapshot snapshot() const noexcept;
+
+    /* event_clock in milliseconds, the time base of add() and snapshot() */
+    static std::int64_t now() noexcept;
+
+ private:
+    using row_t = std::array<std::atomic<std::uint32_t>, apm_snapshot::row_count>;
+
+    /* Tick each bucket was last reset for */
+    std::array<std::atomic<std::int64_t>, bucket_count> m_bucket_tick{};
+    std::array<row_t, bucket_count> m_counts{};
+    std::array<std::atomic<std::uint64_t>, apm_snapshot::row_count> m_totals{};
+    /* Writer only */
+    std::int64_t m_last_tick{-1};
+};
+}  // namespace vnepogodin
+
+namespace local_data {
+/* Fed straight from the hook thread */
+extern vnepogodin::ApmCounter apm;
+}  // namespace local_data
+
+#endif  // APM_COUNTER_HPP
@@ -0,0 +1,144 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef BROADCAST_RING_HPP
+#define BROADCAST_RING_HPP
+
+#include <vnepogodin/ring_buffer.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace vnepogodin {
+
+/**
+ * Single-producer, multi-consumer broadcast queue.
+ *
+ * Every subscriber owns a cursor into one shared ring and sees every value
+ * exactly once. The producer never waits for readers: a subscriber that
+ * falls more than Capacity values behind skips ahead and accounts for the
+ * lost values in its cursor. Each slot is guarded by its own sequence
+ * number, so a reader detects a slot overwritten under its feet.
+ */
+template <class T, std::size_t Capacity>
+class broadcast_ring {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+ public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    class cursor {
+     public:
+        /* Number of values this subscriber missed because it was lapped */
+        constexpr std::uint64_t dropped() const noexcept { return m_dropped; }
+
+     private:
+        friend class broadcast_ring;
+
+        size_type m_pos{};
+        std::uint64_t m_dropped{};
+    };
+
+    broadcast_ring()                      = default;
+    broadcast_ring(const broadcast_ring&) = delete;
+    broadcast_ring& operator=(const broadcast_ring&) = delete;
+
+    /* Creates a cursor which only sees values pushed from now on */
+    cursor subscribe() const noexcept {
+        cursor result;
+        result.m_pos = m_head.load(std::memory_order_acquire);
+        return result;
+    }
+
+    /* Producer side, must only be called from a single thread */
+    void push(const value_type& value) noexcept {
+        const auto& head = m_head.load(std::memory_order_relaxed);
+        auto& slot       = m_slots[head & mask];
+
+        slot.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = value;
+        slot.seq.store(head + 1, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /* Consumer side, each cursor must only be used from a single thread */
+    bool pop(cursor& sub, value_type& value) const noexcept {
+        for (;;) {
+            const auto& head = m_head.load(std::memory_order_acquire);
+            if (sub.m_pos == head) {
+                return false;
+            }
+            if (head - sub.m_pos > Capacity) {
+                sub.m_dropped += head - Capacity - sub.m_pos;
+                sub.m_pos = head - Capacity;
+            }
+
+            const auto& slot = m_slots[sub.m_pos & mask];
+            if (slot.seq.load(std::memory_order_acquire) == sub.m_pos + 1) {
+                value = slot.value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) == sub.m_pos + 1) {
+                    ++sub.m_pos;
+                    return true;
+                }
+            }
+
+            // Producer lapped us while reading, resync on the next round.
+            ++sub.m_dropped;
+            ++sub.m_pos;
+        }
+    }
+
+    /**
+     * Hands every pending value to the callback in one batch.
+     * @return number of values consumed.
+     */
+    template <class Callback>
+    size_type drain(cursor& sub, Callback&& callback) const {
+        size_type count = 0;
+        value_type value{};
+        while (pop(sub, value)) {
+            callback(value);
+            ++count;
+        }
+        return count;
+    }
+
+    static constexpr size_type capacity() noexcept { return Capacity; }
+
+ private:
+    static constexpr size_type mask = Capacity - 1;
+
+    struct slot_type {
+        /* Sequence number of the stored value plus one, zero while written */
+        std::atomic<size_type> seq{};
+        value_type value{};
+    };
+
+    alignas(cache_line_size) std::atomic<size_type> m_head{};
+    alignas(cache_line_size) std::array<slot_type, Capacity> m_slots{};
+};
+}  // namespace vnepogodin
+
+#endif  // BROADCAST_RING_HPP
@@ -0,0 +1,136 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef EVDEV_HOOK_HPP
+#define EVDEV_HOOK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include <uiohook.h>
+
+namespace vnepogodin {
+/**
+ * Linux capture straight from /dev/input/event*, for when XRecord isn't
+ * available (Wayland) or its round trip through the X server is too slow.
+ *
+ * Every keyboard and mouse is read through epoll and turned into the
+ * uiohook_event stream libuiohook produces, timed by the kernel's
+ * monotonic clock. Mice only report relative motion, so the cursor is
+ * tracked inside bounds, without pointer acceleration. Touchpads move it
+ * by their ABS_X / ABS_Y deltas the same way, tablets and touchscreens
+ * place it and a touch counts as the left button. Multitouch slots, taps
+ * and gestures are left out, that takes libinput. Needs read access to
+ * the devices, usually membership in the input group.
+ */
+class EvdevHook final {
+ public:
+    EvdevHook() = default;
+    EvdevHook(const EvdevHook&) = delete;
+    EvdevHook& operator=(const EvdevHook&) = delete;
+    ~EvdevHook();
+
+    /* Desktop the tracked cursor moves in, must be set before run() */
+    inline void set_bounds(const std::int16_t& x, const std::int16_t& y, const std::int16_t& width, const std::int16_t& height) noexcept {
+        m_bounds = {x, y, width, height};
+    }
+
+    /**
+     * Reads these devices instead of scanning /dev/input, e.g. uinput
+     * devices under test. Must be set before run().
+     */
+    inline void set_devices(std::vector<std::filesystem::path> devices) { m_devices = std::move(devices); }
+
+    /**
+     * Blocks dispatching events until stop().
+     * @return UIOHOOK_SUCCESS once stopped, UIOHOOK_FAILURE if no device could be read.
+     */
+    int run(dispatcher_t dispatch_proc);
+
+    /* Thread-safe, makes run() return */
+    void stop() noexcept;
+
+ private:
+    struct rect {
+        std::int16_t x{};
+        std::int16_t y{};
+        std::int16_t width{};
+        std::int16_t height{};
+    };
+
+    struct abs_axis {
+        std::int32_t minimum{};
+        std::int32_t maximum{};
+        /* Units per millimetre, 0 if the device doesn't say */
+        std::int32_t resolution{};
+        /* Touchpads only, the finger's last position and the sub-pixel rest */
+        std::int32_t last{};
+        std::int32_t remainder{};
+        bool tracking{};
+    };
+
+    /* A device reporting ABS_X / ABS_Y */
+    struct abs_device {
+        int fd{-1};
+        /* Moves the cursor by deltas, otherwise positions map onto the bounds */
+        bool touchpad{};
+        abs_axis x{};
+        abs_axis y{};
+        /* BTN_TOUCH of the current frame, -1 if it didn't change */
+        std::int32_t touch{-1};
+    };
+
+    rect m_bounds{};
+    std::vector<std::filesystem::path> m_devices;
+
+    int m_epoll_fd{-1};
+    /* eventfd stop() writes to, read from other threads */
+    std::atomic<int> m_stop_fd{-1};
+    std::vector<int> m_fds;
+    std::vector<abs_device> m_abs_devices;
+
+    /* Hook thread only */
+    dispatcher_t m_dispatch{};
+    uiohook_event m_event{};
+    std::uint16_t m_mask{};
+    std::int16_t m_x{};
+    std::int16_t m_y{};
+    bool m_moved{};
+    /* Set by motion while a button is held, the release then isn't a click */
+    bool m_dragged{};
+    std::uint16_t m_click_button{};
+    std::uint16_t m_click_count{};
+    std::uint64_t m_click_time{};
+
+    bool open_devices();
+    void close_devices() noexcept;
+    void add_abs_device(const int& fd);
+    void read_device(const int& fd);
+    void dispatch(const event_type& type, const std::uint64_t& time);
+    void on_key(const std::uint16_t& code, const std::int32_t& value, const std::uint64_t& time);
+    void on_button(const std::uint16_t& button, const std::int32_t& value, const std::uint64_t& time);
+    void on_wheel(const std::int32_t& value, const std::uint8_t& direction, const std::uint64_t& time);
+    void on_abs(abs_device& device, const std::uint16_t& code, const std::int32_t& value) noexcept;
+    void on_frame(const std::uint64_t& time);
+};
+}  // namespace vnepogodin
+
+#endif  // EVDEV_HOOK_HPP
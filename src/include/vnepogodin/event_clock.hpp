@@ -0,0 +1,56 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef EVENT_CLOCK_HPP
+#define EVENT_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include <uiohook.h>
+
+namespace vnepogodin {
+/**
+ * Time base of captured events.
+ *
+ * uiohook_event::time is whatever the backend reports, e.g. the X server's
+ * millisecond clock, so dispatch_proc stamps every event with steady_clock
+ * nanoseconds as it arrives and that stamp travels with the event.
+ */
+namespace event_clock {
+    static constexpr std::int64_t ns_per_us = 1000;
+    static constexpr std::int64_t ns_per_ms = 1000000;
+
+    /* Monotonic nanoseconds */
+    inline std::int64_t now() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}  // namespace event_clock
+
+/* Event as it travels on the event bus */
+struct timed_event {
+    uiohook_event event{};
+    /* event_clock::now() when dispatch_proc received it */
+    std::int64_t time_ns{};
+};
+static_assert(std::is_trivially_copyable<timed_event>::value, "timed_event must stay memcpy-able");
+}  // namespace vnepogodin
+
+#endif  // EVENT_CLOCK_HPP
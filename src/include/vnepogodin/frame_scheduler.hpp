@@ -0,0 +1,71 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+namespace vnepogodin {
+/**
+ * Turns input notifications into at most one frame per display refresh.
+ * Nothing runs while there is no input, so an idle overlay costs no wakeups.
+ */
+class FrameScheduler final : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(FrameScheduler)
+ public:
+    explicit FrameScheduler(QObject* parent = nullptr);
+    virtual ~FrameScheduler() = default;
+
+    /**
+     * Asks for a new frame. Thread-safe, called from the hook thread.
+     */
+    void requestFrame() noexcept;
+
+    /**
+     * Adapter for uiohook::set_notify_proc.
+     */
+    static void notify_proc(void* user_data) noexcept;
+
+ signals:
+    /**
+     * Emitted on the GUI thread when the input state changed.
+     */
+    void frame();
+
+ private:
+    std::atomic<bool> m_pending{};
+    std::uint64_t m_generation{};
+
+    qint64 m_interval_ns{};
+    qint64 m_last_frame_ns{};
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+
+    void schedule();
+    void emitFrame();
+};
+}  // namespace vnepogodin
+
+#endif  // FRAME_SCHEDULER_HPP
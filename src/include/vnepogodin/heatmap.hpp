@@ -0,0 +1,89 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef HEATMAP_HPP
+#define HEATMAP_HPP
+
+#include <vnepogodin/event_clock.hpp>
+#include <vnepogodin/heatmap_file.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+namespace vnepogodin {
+/**
+ * Where the cursor spends its time, on a fixed heatmap_file grid.
+ *
+ * Each motion event credits the time since the previous one to the cell
+ * the cursor was resting in, capped so an idle cursor doesn't drown out
+ * the rest. add() is called from the hook thread only and is O(1),
+ * save() may run on any thread and sees every cell up to date or one
+ * event behind.
+ */
+class Heatmap final {
+ public:
+    /* Longest rest credited to a single cell, in nanoseconds */
+    static constexpr std::int64_t max_dwell_ns = 1000 * event_clock::ns_per_ms;
+
+    Heatmap() = default;
+
+    /* Must be set before the hook starts, clears the grid if the desktop changed */
+    void set_geometry(const heatmap_file::geometry& desktop) noexcept;
+
+    /**
+     * Adds what was recorded before with the same desktop.
+     * Must be called before the hook starts.
+     */
+    bool load(const std::filesystem::path& path);
+
+    /**
+     * Writes the grid if it changed since the last save.
+     * @return false if writing failed.
+     */
+    bool save(const std::filesystem::path& path);
+
+    /**
+     * Moves the cursor.
+     * @param time_ns is an event_clock timestamp.
+     */
+    void add(const std::int16_t& x, const std::int16_t& y, const std::int64_t& time_ns) noexcept;
+
+ private:
+    std::array<std::atomic<std::uint32_t>, heatmap_file::cell_count> m_cells{};
+    heatmap_file::geometry m_desktop{};
+    /* Bumped by add(), lets save() skip an idle grid */
+    std::atomic<std::uint64_t> m_version{};
+    std::uint64_t m_saved_version{};
+
+    /* Writer only */
+    std::size_t m_cell{heatmap_file::cell_count};
+    std::int64_t m_last_time{};
+    std::uint32_t m_dwell_ns{};
+
+    std::size_t cell(const std::int16_t& x, const std::int16_t& y) const noexcept;
+};
+}  // namespace vnepogodin
+
+namespace local_data {
+/* Fed straight from the hook thread */
+extern vnepogodin::Heatmap heatmap;
+}  // namespace local_data
+
+#endif  // HEATMAP_HPP
@@ -0,0 +1,125 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef HEATMAP_FILE_HPP
+#define HEATMAP_FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Persisted cursor heatmap.
+ *
+ * Layout (little-endian):
+ *   file_header
+ *   dwell uint32[rows][cols]  milliseconds the cursor spent in each cell
+ *
+ * Cells split the desktop the grid was recorded on into a fixed number
+ * of rows and columns, so the file has the same size however long the
+ * recording ran. Files are replaced atomically, readers never see a half
+ * written grid.
+ */
+namespace vnepogodin {
+namespace heatmap_file {
+    static constexpr std::array<char, 4> file_magic = {'G', 'T', 'H', 'M'};
+    static constexpr std::uint16_t version          = 1;
+    static constexpr std::uint32_t cols             = 256;
+    static constexpr std::uint32_t rows             = 144;
+    static constexpr std::size_t cell_count         = static_cast<std::size_t>(cols) * rows;
+
+    /* Desktop the grid covers, in hook coordinates */
+    struct geometry {
+        std::int32_t x{};
+        std::int32_t y{};
+        std::int32_t width{};
+        std::int32_t height{};
+
+        inline bool operator==(const geometry& other) const noexcept {
+            return x == other.x && y == other.y && width == other.width && height == other.height;
+        }
+        inline bool operator!=(const geometry& other) const noexcept { return !(*this == other); }
+    };
+
+    struct file_header {
+        std::array<char, 4> magic{file_magic};
+        std::uint16_t version{heatmap_file::version};
+        std::uint16_t reserved{};
+        std::uint32_t cols{heatmap_file::cols};
+        std::uint32_t rows{heatmap_file::rows};
+        geometry desktop{};
+    };
+    static_assert(sizeof(file_header) == 32 && std::is_trivially_copyable<file_header>::value);
+
+    using grid = std::vector<std::uint32_t>;
+
+    /* Where the overlay keeps its heatmap */
+    inline std::filesystem::path default_path() {
+        std::error_code ec;
+        const auto& dir = std::filesystem::temp_directory_path(ec);
+        return (ec ? std::filesystem::path(".") : dir) / "goattech_heatmap.bin";
+    }
+
+    /**
+     * @return false if the file is missing or wasn't written by this version.
+     */
+    inline bool read(const std::filesystem::path& path, file_header& header, grid& cells) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input.read(reinterpret_cast<char*>(&header), sizeof(file_header))) {
+            return false;
+        }
+        if (header.magic != file_magic || header.version != version || header.cols != cols || header.rows != rows) {
+            return false;
+        }
+
+        cells.resize(cell_count);
+        return static_cast<bool>(input.read(reinterpret_cast<char*>(cells.data()), static_cast<std::streamsize>(cell_count * sizeof(std::uint32_t))));
+    }
+
+    /* Writes next to the target first, then swaps it in */
+    inline bool write(const std::filesystem::path& path, const geometry& desktop, const grid& cells) {
+        if (cells.size() != cell_count) {
+            return false;
+        }
+
+        auto temp_path = path;
+        temp_path += ".tmp";
+        {
+            std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+            file_header header{};
+            header.desktop = desktop;
+            output.write(reinterpret_cast<const char*>(&header), sizeof(file_header));
+            output.write(reinterpret_cast<const char*>(cells.data()), static_cast<std::streamsize>(cell_count * sizeof(std::uint32_t)));
+            if (!output.flush()) {
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        return !ec;
+    }
+}  // namespace heatmap_file
+}  // namespace vnepogodin
+
+#endif  // HEATMAP_FILE_HPP
@@ -19,20 +19,21 @@
 #ifndef INPUT_DATA_HPP
 #define INPUT_DATA_HPP
 
-#include <mutex>
-#include <unordered_map>
+#include <vnepogodin/key_bitset.hpp>
+#include <vnepogodin/key_layout.hpp>
+#include <vnepogodin/seqlock.hpp>
 
-#include <uiohook.h>
+#include <type_traits>
 
-/* Holds all input data for a computer, local or remote */
-struct input_data {
-    std::mutex m_mutex;
+#include <uiohook.h>
 
-    /* State of all keyboard keys*/
-    std::unordered_map<uint16_t, bool> keyboard{};
+/* Plain copy of the input state, cheap to snapshot */
+struct input_snapshot {
+    /* State of all keyboard keys, indexed by vnepogodin::keycode_index */
+    vnepogodin::keyboard_bitset keyboard{};
 
     /* State of all mouse buttons */
-    std::unordered_map<uint16_t, bool> mouse{};
+    vnepogodin::mouse_bitset mouse{};
 
     /* Last uiohook events */
     keyboard_event_data last_key_pressed{}, last_key_released{}, last_key_typed{};
@@ -41,14 +42,50 @@ struct input_data {
     mouse_wheel_event_data last_wheel_event{};
     uiohook_event last_event{};
 
-    /* Mutex needs to be locked */
+    inline bool is_key_pressed(const std::uint16_t& keycode) const noexcept {
+        return keyboard.test(vnepogodin::keycode_index(keycode));
+    }
+    inline bool is_button_pressed(const std::uint16_t& button) const noexcept {
+        return mouse.test(button);
+    }
+    inline bool is_pressed(const vnepogodin::layout::key_info& key) const noexcept {
+        return (key.source == vnepogodin::layout::device::keyboard) ? is_key_pressed(key.code) : is_button_pressed(key.code);
+    }
+};
+static_assert(std::is_trivially_copyable<input_snapshot>::value, "input_snapshot must stay memcpy-able");
+
+/**
+ * Holds all input data for a computer, local or remote.
+ * Fields belong to the thread calling dispatch_uiohook_event. A shared
+ * instance publishes every change, so other threads can read it through
+ * snapshot(); others skip that and are only read by their own thread.
+ */
+struct input_data : input_snapshot {
+    explicit input_data(const bool& shared = false) noexcept : m_shared(shared) { }
+
+    /* Must be called from the writer thread */
     void copy(const input_data* other);
 
+    /* Returns the last published state, never blocks the writer */
+    inline input_snapshot snapshot() const noexcept {
+        return m_shared ? m_published.load() : static_cast<const input_snapshot&>(*this);
+    }
+
+    /* Changes whenever the state changes */
+    inline std::uint64_t generation() const noexcept { return m_shared ? m_published.version() : m_generation; }
+
     void dispatch_uiohook_event(const uiohook_event* event);
+
+ private:
+    bool m_shared{};
+    std::uint64_t m_generation{};
+    vnepogodin::seqlock<input_snapshot> m_published;
+
+    void publish() noexcept;
 };
 
 namespace local_data {
-extern std::mutex data_mutex;
+/* Updated straight from the hook thread, the only shared instance */
 extern input_data data;
 }  // namespace local_data
 
@@ -0,0 +1,146 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef KEY_BITSET_HPP
+#define KEY_BITSET_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace vnepogodin {
+
+/**
+ * Fixed-size set of pressed keys, one bit per key.
+ *
+ * Words are plain integers, so the whole set is trivially copyable and
+ * any()/diff() compile down to a handful of (vectorizable) word operations.
+ */
+template <std::size_t Bits>
+class key_bitset {
+    static_assert(Bits > 0 && Bits % 64 == 0, "Bits must be a multiple of 64");
+
+ public:
+    using word_type                         = std::uint64_t;
+    static constexpr std::size_t word_bits  = 64;
+    static constexpr std::size_t word_count = Bits / word_bits;
+
+    static constexpr std::size_t size() noexcept { return Bits; }
+
+    constexpr bool test(const std::size_t& idx) const noexcept {
+        if (idx >= Bits) {
+            return false;
+        }
+        return (m_words[idx / word_bits] >> (idx % word_bits)) & 1U;
+    }
+
+    constexpr void set(const std::size_t& idx, const bool& value = true) noexcept {
+        if (idx >= Bits) {
+            return;
+        }
+        const word_type& bit = word_type{1} << (idx % word_bits);
+        if (value) {
+            m_words[idx / word_bits] |= bit;
+        } else {
+            m_words[idx / word_bits] &= ~bit;
+        }
+    }
+
+    constexpr void reset() noexcept { m_words = {}; }
+
+    /* True if at least one key is pressed */
+    constexpr bool any() const noexcept {
+        word_type acc{};
+        for (const auto& word : m_words) {
+            acc |= word;
+        }
+        return acc != 0;
+    }
+
+    constexpr std::size_t count() const noexcept {
+        std::size_t result{};
+        for (const auto& word : m_words) {
+            result += static_cast<std::size_t>(std::popcount(word));
+        }
+        return result;
+    }
+
+    /* Keys whose state differs between both sets */
+    constexpr key_bitset diff(const key_bitset& other) const noexcept {
+        key_bitset result;
+        for (std::size_t i = 0; i < word_count; ++i) {
+            result.m_words[i] = m_words[i] ^ other.m_words[i];
+        }
+        return result;
+    }
+
+    /* Calls func(index) for every set bit, in ascending order */
+    template <class Func>
+    constexpr void for_each(Func&& func) const {
+        for (std::size_t i = 0; i < word_count; ++i) {
+            auto word = m_words[i];
+            while (word != 0) {
+                func(i * word_bits + static_cast<std::size_t>(std::countr_zero(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    constexpr bool operator==(const key_bitset&) const noexcept = default;
+
+ private:
+    std::array<word_type, word_count> m_words{};
+};
+
+/**
+ * Folds a sparse VC_* keycode into a dense index.
+ * libuiohook keycodes are a scancode (< 0x80) plus a bank in the high byte.
+ */
+constexpr std::size_t keycode_index(const std::uint16_t& keycode) noexcept {
+    std::size_t bank{};
+    switch (keycode >> 8U) {
+    case 0x00:
+        bank = 0;
+        break;
+    case 0x0E:
+        bank = 1;
+        break;
+    case 0xE0:
+        bank = 2;
+        break;
+    case 0xEE:
+        bank = 3;
+        break;
+    case 0xFF:
+        bank = 4;
+        break;
+    default:
+        bank = 7;
+        break;
+    }
+    return (bank << 7U) | (keycode & 0x7FU);
+}
+
+/* Enough bits for every bank produced by keycode_index */
+using keyboard_bitset = key_bitset<1024>;
+/* Indexed by MOUSE_BUTTON* */
+using mouse_bitset = key_bitset<64>;
+}  // namespace vnepogodin
+
+#endif  // KEY_BITSET_HPP
@@ -0,0 +1,134 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef KEY_LAYOUT_HPP
+#define KEY_LAYOUT_HPP
+
+#include <vnepogodin/key_bitset.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <uiohook.h>
+
+namespace vnepogodin {
+namespace utils {
+    namespace key_code {
+        static constexpr std::uint8_t LBUTTON = MOUSE_BUTTON1;
+        /* clang-format off */
+#ifndef _WIN32
+        static constexpr std::uint8_t RBUTTON = MOUSE_BUTTON3;
+        static constexpr std::uint8_t MBUTTON = MOUSE_BUTTON2;
+#else
+        static constexpr std::uint8_t RBUTTON = MOUSE_BUTTON2;
+        static constexpr std::uint8_t MBUTTON = MOUSE_BUTTON3;
+#endif
+        /* clang-format on */
+        static constexpr std::uint8_t X1BUTTON = MOUSE_BUTTON4;
+        static constexpr std::uint8_t X2BUTTON = MOUSE_BUTTON5;
+
+        static constexpr std::uint32_t W         = VC_W;
+        static constexpr std::uint32_t A         = VC_A;
+        static constexpr std::uint32_t S         = VC_S;
+        static constexpr std::uint32_t D         = VC_D;
+        static constexpr std::uint32_t Q         = VC_Q;
+        static constexpr std::uint32_t E         = VC_E;
+        static constexpr std::uint32_t SHIFT     = VC_SHIFT_L;
+        static constexpr std::uint32_t CONTROL   = VC_CONTROL_L;
+        static constexpr std::uint32_t SPACEBAR  = VC_SPACE;
+        static constexpr std::uint32_t UNDEFINED = VC_UNDEFINED;
+    }  // namespace key_code
+}  // namespace utils
+
+namespace layout {
+    enum class device : std::uint8_t {
+        keyboard,
+        mouse
+    };
+
+    /* A key GOATTech tracks: where it comes from, its asset and where the overlay draws it */
+    struct key_info {
+        device source;
+        std::uint16_t code;
+        std::string_view name;
+        /* Position inside the overlay's base svg */
+        int x;
+        int y;
+    };
+
+    /* clang-format off */
+    static constexpr std::array keys = {
+        key_info{device::keyboard, utils::key_code::W,        "w_button",      384, 0},
+        key_info{device::keyboard, utils::key_code::A,        "a_button",      169, 182},
+        key_info{device::keyboard, utils::key_code::S,        "s_button",      338, 182},
+        key_info{device::keyboard, utils::key_code::D,        "d_button",      508, 182},
+        key_info{device::keyboard, utils::key_code::Q,        "q_button",      210, 0},
+        key_info{device::keyboard, utils::key_code::E,        "e_button",      552, 0},
+        key_info{device::keyboard, utils::key_code::SHIFT,    "shift_button",  0,   182},
+        key_info{device::keyboard, utils::key_code::CONTROL,  "ctrl_button",   23,  360},
+        key_info{device::keyboard, utils::key_code::SPACEBAR, "space_button",  192, 360},
+        key_info{device::mouse,    utils::key_code::LBUTTON,  "left_button",   10,  0},
+        key_info{device::mouse,    utils::key_code::RBUTTON,  "right_button",  512, 0},
+        key_info{device::mouse,    utils::key_code::MBUTTON,  "middle_button", 415, 273},
+        key_info{device::mouse,    utils::key_code::X1BUTTON, "x_button",      2,   735},
+        key_info{device::mouse,    utils::key_code::X2BUTTON, "x_button",      41,  960},
+    };
+    /* clang-format on */
+
+    using key_index_t                      = std::uint8_t;
+    static constexpr key_index_t npos      = 0xFF;
+    static constexpr std::size_t key_count = keys.size();
+    static_assert(key_count < npos, "key_index_t is too small for the layout");
+
+    namespace detail {
+        template <device Source, std::size_t Size, class Fold>
+        constexpr auto make_lookup(Fold&& fold) noexcept {
+            std::array<key_index_t, Size> result{};
+            result.fill(npos);
+            for (std::size_t i = 0; i < key_count; ++i) {
+                if (keys[i].source == Source) {
+                    result[fold(keys[i].code)] = static_cast<key_index_t>(i);
+                }
+            }
+            return result;
+        }
+
+        /* keycode_index(VC_*) -> position in keys */
+        static constexpr auto keyboard_lookup = make_lookup<device::keyboard, keyboard_bitset::size()>(
+            [](const std::uint16_t& code) { return keycode_index(code); });
+        /* MOUSE_BUTTON* -> position in keys */
+        static constexpr auto mouse_lookup = make_lookup<device::mouse, mouse_bitset::size()>(
+            [](const std::uint16_t& code) { return static_cast<std::size_t>(code); });
+    }  // namespace detail
+
+    /**
+     * O(1) mapping of a raw keycode or mouse button to its position in keys.
+     * @return npos if GOATTech doesn't track the key.
+     */
+    constexpr key_index_t key_index(const device& source, const std::uint16_t& code) noexcept {
+        if (source == device::keyboard) {
+            return detail::keyboard_lookup[keycode_index(code)];
+        }
+        return (code < detail::mouse_lookup.size()) ? detail::mouse_lookup[code] : npos;
+    }
+}  // namespace layout
+}  // namespace vnepogodin
+
+#endif  // KEY_LAYOUT_HPP
@@ -0,0 +1,149 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef LATENCY_TRACER_HPP
+#define LATENCY_TRACER_HPP
+
+#include <vnepogodin/event_clock.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace vnepogodin {
+/**
+ * HDR-style histogram of durations in nanoseconds.
+ *
+ * Buckets are log-linear: every power of two is split into sub_bucket_count
+ * equal slots, so a percentile is off by less than 1/sub_bucket_count of
+ * its value from 1 ns up to max_value, in a fixed amount of memory.
+ */
+class latency_histogram final {
+ public:
+    static constexpr std::uint32_t sub_bucket_bits = 7;
+    static constexpr std::int64_t sub_bucket_count = std::int64_t{1} << sub_bucket_bits;
+    /* Larger durations are counted as max_value, ~68 s */
+    static constexpr std::uint32_t max_value_bits = 36;
+    static constexpr std::int64_t max_value       = (std::int64_t{1} << max_value_bits) - 1;
+    static constexpr std::size_t bucket_count     = static_cast<std::size_t>((max_value_bits - sub_bucket_bits + 1) * sub_bucket_count);
+
+    void record(const std::int64_t& value_ns) noexcept;
+    void reset() noexcept;
+
+    inline std::uint64_t count() const noexcept { return m_count; }
+    inline std::int64_t min() const noexcept { return (m_count > 0) ? m_min : 0; }
+    inline std::int64_t max() const noexcept { return m_max; }
+    inline std::int64_t mean() const noexcept { return (m_count > 0) ? static_cast<std::int64_t>(m_sum / m_count) : 0; }
+
+    /**
+     * @param quantile is in [0, 1], e.g. 0.99 for p99.
+     * @return highest value of the bucket the quantile falls in, 0 if empty.
+     */
+    std::int64_t percentile(const double& quantile) const noexcept;
+
+ private:
+    std::array<std::uint64_t, bucket_count> m_buckets{};
+    std::uint64_t m_count{};
+    std::uint64_t m_sum{};
+    std::int64_t m_min{max_value};
+    std::int64_t m_max{};
+
+    static std::size_t bucket(const std::int64_t& value) noexcept;
+    static std::int64_t highest_value(const std::size_t& bucket) noexcept;
+};
+
+/**
+ * Input-to-photon tracing for the overlays.
+ *
+ * Every press or release an overlay dequeues is followed until the end of
+ * the overlay's next paint, which is as close to the screen as Qt lets us
+ * see. The hook stamp comes with the event, the overlay adds dequeue,
+ * paint start and paint end. GUI thread only.
+ */
+class LatencyTracer final {
+ public:
+    enum class stage : std::uint8_t {
+        queue,
+        paint_start,
+        paint_end,
+        paint
+    };
+    static constexpr std::size_t stage_count = 4;
+    static constexpr std::array<std::string_view, stage_count> stage_names = {
+        "hook -> dequeue", "hook -> paint start", "hook -> paint end", "paint"};
+
+    /* Events an overlay dequeued but hasn't painted yet */
+    struct trace {
+        std::int64_t hook{};
+        std::int64_t dequeue{};
+    };
+    using pending_t = std::vector<trace>;
+    /* Once this many wait for a paint, newer events aren't traced */
+    static constexpr std::size_t max_pending = 256;
+
+    LatencyTracer() = default;
+
+    /**
+     * Starts following an event.
+     * @param time_ns is the event_clock stamp at dequeue.
+     */
+    inline void dequeued(pending_t& pending, const timed_event& event, const std::int64_t& time_ns) const {
+        if (pending.size() < max_pending) {
+            pending.push_back({event.time_ns, time_ns});
+        }
+    }
+
+    /* Records the pending traces against a finished paint and clears them */
+    void painted(pending_t& pending, const std::int64_t& start_ns, const std::int64_t& end_ns) noexcept;
+
+    inline const latency_histogram& histogram(const stage& which) const noexcept {
+        return m_histograms[static_cast<std::size_t>(which)];
+    }
+
+    void reset() noexcept;
+
+    /* Count and p50/p99/p999/max per stage, one line each */
+    std::string report() const;
+
+    /* Writes report() to path */
+    bool dump(const std::filesystem::path& path) const;
+
+    /* Where the overlay dumps its report */
+    static inline std::filesystem::path default_path() {
+        std::error_code ec;
+        const auto& dir = std::filesystem::temp_directory_path(ec);
+        return (ec ? std::filesystem::path(".") : dir) / "goattech_latency.txt";
+    }
+
+ private:
+    std::array<latency_histogram, stage_count> m_histograms{};
+};
+}  // namespace vnepogodin
+
+namespace local_data {
+/* Shared by the overlays, GUI thread only */
+extern vnepogodin::LatencyTracer latency;
+}  // namespace local_data
+
+#endif  // LATENCY_TRACER_HPP
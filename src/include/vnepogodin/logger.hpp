@@ -19,147 +19,363 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
-#ifdef _WIN32
-#include <Windows.h>
-#include <tlhelp32.h>  // PROCESSENTRY32W, CreateToolhelp32Snapshot, Process32FirstW, Process32NextW
-#else
-#include <cstring>
-#include <dirent.h>
-#endif
+#include <vnepogodin/event_clock.hpp>
+#include <vnepogodin/process_watcher.hpp>
+#include <vnepogodin/ring_buffer.hpp>
+#include <vnepogodin/session_log.hpp>
 
+#include <atomic>
 #include <chrono>
-#include <fstream>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
-#include <nlohmann/json.hpp>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
 
-namespace {
-#ifdef _WIN32
-std::string_view get_process_list() {
-    // Take a snapshot of all processes in the system.
-    HANDLE hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+namespace vnepogodin {
+/**
+ * Key logger.
+ *
+ * The hook thread only enqueues a POD record, a writer thread
+ * owns the file and turns records into session log blocks. The writer also
+ * watches which game is running and closes a segment whenever it changes,
+ * so every block belongs to exactly one game.
+ *
+ * Full logs are rotated to "<stem>-<unix ms>.bin". A housekeeping thread
+ * compresses them and deletes them oldest first once they exceed the
+ * retention budget, so the writer never stalls on either.
+ */
+class Logger final {
+ public:
+    /* Records buffered before a block is written out */
+    static constexpr std::size_t flush_size = 4096;
+    /* Longest time a record may sit in memory */
+    static constexpr std::chrono::seconds flush_interval{30};
+    /* How often the writer thread drains the queue */
+    static constexpr std::chrono::milliseconds poll_interval{100};
+    /* How often the running game is checked */
+    static constexpr std::chrono::seconds watch_interval{2};
+    static constexpr std::size_t queue_size = 8192;
 
-    // Set the size of the structure before using it.
-    PROCESSENTRY32W pe32{};
-    pe32.dwSize = sizeof(PROCESSENTRY32W);
+    struct stats_t {
+        /* Records rejected because the writer fell behind */
+        std::uint64_t dropped{};
+        /* Deepest the queue has been, a full queue means drops */
+        std::uint64_t queue_high_water{};
+        std::uint64_t written{};
+        std::uint64_t blocks{};
+    };
 
-    // Retrieve information about the first process,
-    // and exit if unsuccessful
-    if (!Process32FirstW(hProcessSnap, &pe32)) {
-        CloseHandle(hProcessSnap);  // clean the snapshot object
-        return "Unknown process";
+    Logger() = default;
+    virtual ~Logger() { close(); }
+
+    /**
+     * Must be called before start().
+     */
+    inline auto set_policy(const session_log::rotation_policy& policy) noexcept -> void {
+        m_policy = policy;
     }
 
-    // Now walk the snapshot of processes, and
-    // display information about each process in turn
-    const std::unordered_map<std::string_view, std::string_view> process_map = {
-        {"dota.exe", "Dota"},
-        {"csgo.exe", "Counter-Strike: Global Offensive"},
-        {"lol.exe", "League of Legends"},
-        {"fortnite.exe", "Fortnite"}};
-    do {
-        std::wstring wide = pe32.szExeFile;
-        std::string exe(wide.begin(), wide.end());
-        for (const auto& [process, name] : process_map) {
-            if (process == exe) {
-                CloseHandle(hProcessSnap);
-                return name;
-            }
+    /**
+     * Opens the log and starts the writer thread.
+     */
+    auto start() -> bool {
+        if (m_running.load(std::memory_order_relaxed)) {
+            return true;
         }
-    } while (Process32NextW(hProcessSnap, &pe32));
 
-    CloseHandle(hProcessSnap);
-    return "Unknown process";
-}
-#else
-std::string_view get_process_list() {
-    DIR* dir_proc = opendir("/proc/");
-    if (dir_proc == NULL) {
-        return "Unknown process";
+        m_log_path = session_log::default_path();
+        if (!m_log_output.open(m_log_path)) {
+            return false;
+        }
+        m_log_opened = std::chrono::steady_clock::now();
+
+        // Event stamps are monotonic, the log wants wall-clock time.
+        m_clock_offset = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count()
+            - event_clock::now();
+
+        m_processes.refresh();
+        m_segment    = {now(), 0, m_processes.current()};
+        m_last_flush = std::chrono::steady_clock::now();
+        m_last_watch = m_last_flush;
+        m_running.store(true, std::memory_order_release);
+        m_housekeeping_stop = false;
+        m_housekeeper       = std::thread(&Logger::housekeep, this);
+        m_writer            = std::thread(&Logger::run, this);
+        return true;
     }
 
-    // Retrieve information about the first process,
-    // and exit if unsuccessful
-    struct dirent* dir_entity = readdir(dir_proc);
-
-    // Now walk the snapshot of processes, and
-    // display information about each process in turn
-    const std::unordered_map<std::string_view, std::string_view>& process_map = {
-        {"dota", "Dota"},
-        {"csgo", "Counter-Strike: Global Offensive"}};
-    do {
-        if (dir_entity->d_type == DT_DIR) {
-            const std::string& chrarry_CommandLinePath = "/proc/" + std::string(dir_entity->d_name) + "/cmdline";
-            std::ifstream in(std::string(chrarry_CommandLinePath), std::ios_base::in);
-            if (in) {
-                const std::vector<std::uint8_t> buffer(std::istreambuf_iterator<char>(in), {});
-                std::string exe(reinterpret_cast<const char*>(buffer.data()), buffer.size());
-                const char* found = strrchr(exe.data(), '/');
-                if (found) {
-                    exe = found + 1;
-                }
+    /**
+     * Called from the hook thread, never blocks.
+     * @param key is the position in vnepogodin::layout::keys.
+     * @param type is the uiohook event type (press or release).
+     * @param time_ns is the event's event_clock stamp.
+     */
+    inline auto add_key(const std::uint8_t& key, const std::uint8_t& type, const std::int64_t& time_ns) noexcept -> void {
+        if (!m_queue.push({time_ns + m_clock_offset, key, type})) {
+            return;
+        }
+
+        // Sampled right after the push, where the queue is deepest.
+        const std::uint64_t& depth = m_queue.size();
+        auto high_water            = m_high_water.load(std::memory_order_relaxed);
+        while (depth > high_water && !m_high_water.compare_exchange_weak(high_water, depth, std::memory_order_relaxed)) { }
+    }
+
+    /**
+     * Stops the writer thread after it has written everything queued,
+     * stats() are final afterwards.
+     */
+    inline auto close() -> void {
+        if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        m_writer.join();
+        m_log_output.close();
+
+        // Logs still waiting are picked up by the next start().
+        {
+            const std::lock_guard<std::mutex> lock(m_housekeeping_mutex);
+            m_housekeeping_stop = true;
+        }
+        m_housekeeping_cv.notify_one();
+        m_housekeeper.join();
+    }
 
-                for (const auto& [process, name] : process_map) {
-                    if (process == exe) {
-                        closedir(dir_proc);
-                        return name;
-                    }
+    inline auto stats() const noexcept -> stats_t {
+        return {m_queue.dropped(), m_high_water.load(std::memory_order_relaxed),
+            m_written.load(std::memory_order_relaxed), m_blocks.load(std::memory_order_relaxed)};
+    }
+
+ private:
+    ring_buffer<session_log::record, queue_size> m_queue{};
+    std::atomic<bool> m_running{};
+    std::thread m_writer{};
+    /* Unix nanoseconds minus event_clock, fixed by start() */
+    std::int64_t m_clock_offset{};
+
+    std::atomic<std::uint64_t> m_high_water{};
+    std::atomic<std::uint64_t> m_written{};
+    std::atomic<std::uint64_t> m_blocks{};
+
+    struct segment_t {
+        std::int64_t start_time{};
+        std::uint32_t count{};
+        ProcessWatcher::game_index_t game{ProcessWatcher::npos};
+    };
+
+    /* Writer thread state */
+    session_log::rotation_policy m_policy{};
+    std::filesystem::path m_log_path{};
+    std::chrono::steady_clock::time_point m_log_opened{};
+    session_log::writer m_log_output{};
+    ProcessWatcher m_processes{};
+    segment_t m_segment{};
+    std::chrono::steady_clock::time_point m_last_flush{};
+    std::chrono::steady_clock::time_point m_last_watch{};
+
+    /* Rotated logs handed from the writer to the housekeeping thread */
+    std::mutex m_housekeeping_mutex{};
+    std::condition_variable m_housekeeping_cv{};
+    std::vector<std::filesystem::path> m_rotated{};
+    bool m_housekeeping_stop{};
+    std::thread m_housekeeper{};
+
+    /* Unix time in milliseconds on the records' clock, the time base of segments */
+    inline std::int64_t now() const noexcept {
+        return (event_clock::now() + m_clock_offset) / event_clock::ns_per_ms;
+    }
+
+    void run() {
+        while (m_running.load(std::memory_order_acquire)) {
+            drain();
+
+            const auto& steady_now = std::chrono::steady_clock::now();
+            if (steady_now - m_last_watch >= watch_interval) {
+                m_last_watch = steady_now;
+                if (m_processes.refresh()) {
+                    end_segment(m_processes.current());
                 }
             }
+            if (m_log_output.pending() >= flush_size || steady_now - m_last_flush >= flush_interval) {
+                flush();
+            }
+            if (m_log_output.size() > sizeof(session_log::file_header)
+                && (m_log_output.size() >= m_policy.max_size || steady_now - m_log_opened >= m_policy.max_age)) {
+                rotate();
+            }
+            std::this_thread::sleep_for(poll_interval);
         }
-    } while ((dir_entity = readdir(dir_proc)));
 
-    closedir(dir_proc);
-    return "Unknown process";
-}
-#endif
-}  // namespace
-
-namespace vnepogodin {
-class Logger final {
- public:
-    Logger() {
-        /* clang-format off */
-        m_json = {
-            {"name", get_process_list()},
-            {"timestamp", 0},
-            {"keys", nlohmann::json::array()}};
-        /* clang-format on */
-
-#ifdef _WIN32
-        char buf[100]{};
-        GetTempPathA(85, buf);
-        const std::string file = std::string(buf) + "db.json";
-#else
-        static constexpr std::string_view file = "/tmp/db.json";
-#endif
-        m_log_output.open(file.data(), std::ofstream::app);
+        // The hook is stopped by now, pick up whatever it left behind.
+        drain();
+        end_segment(ProcessWatcher::npos);
     }
 
-    virtual ~Logger() = default;
+    /**
+     * Writes out the current segment and starts a new one for game.
+     * Idle time outside of any game isn't worth a record.
+     */
+    void end_segment(const ProcessWatcher::game_index_t& game) {
+        flush();
 
-    inline auto write() -> void {
-        if (!m_json["keys"].empty()) {
-            m_json.at("name")      = get_process_list();
-            m_json.at("timestamp") = std::chrono::system_clock::to_time_t(
-                std::chrono::system_clock::now());
-            m_log_output << m_json << '\n';
-            m_json["keys"].clear();
+        const auto& end_time = now();
+        if (m_segment.game != ProcessWatcher::npos || m_segment.count > 0) {
+            m_log_output.add_segment(m_segment.start_time, end_time, m_segment.count, ProcessWatcher::name(m_segment.game));
         }
+        m_segment = {end_time, 0, game};
     }
 
-    inline auto add_key(const std::string_view& value) -> void {
-        m_json["keys"].push_back(value);
+    void drain() {
+        session_log::record record{};
+        while (m_queue.pop(record)) {
+            m_log_output.add(record.time, record.key, record.type);
+            ++m_segment.count;
+            if (m_log_output.pending() >= flush_size) {
+                flush();
+            }
+        }
     }
 
-    inline auto close() -> void {
+    /**
+     * Moves the log aside and starts a new one, the open segment carries on
+     * in the new file.
+     */
+    void rotate() {
+        flush();
         m_log_output.close();
+
+        std::error_code ec;
+        const auto& rotated = session_log::rotated_path(m_log_path, now());
+        std::filesystem::rename(m_log_path, rotated, ec);
+        if (!ec) {
+            std::filesystem::rename(session_log::index_path(m_log_path), session_log::index_path(rotated), ec);
+        }
+
+        m_log_output.open(m_log_path);
+        m_log_opened = std::chrono::steady_clock::now();
+
+        {
+            const std::lock_guard<std::mutex> lock(m_housekeeping_mutex);
+            m_rotated.push_back(rotated);
+        }
+        m_housekeeping_cv.notify_one();
     }
 
- private:
-    std::ofstream m_log_output{};
-    nlohmann::json m_json;
+    /**
+     * Compresses rotated logs and enforces retention, one file at a time so
+     * retention never deletes a log that is being compressed.
+     */
+    void housekeep() {
+        // Finish what a previous run didn't get to, e.g. it quit mid-compression.
+        if (m_policy.compress) {
+            for (const auto& file : session_log::rotated_files(m_log_path)) {
+                if (file.extension() != session_log::compressed_suffix) {
+                    compress(file);
+                }
+            }
+        }
+        enforce_retention();
+
+        std::unique_lock<std::mutex> lock(m_housekeeping_mutex);
+        while (true) {
+            m_housekeeping_cv.wait(lock, [this] { return m_housekeeping_stop || !m_rotated.empty(); });
+            if (m_housekeeping_stop) {
+                m_rotated.clear();
+                return;
+            }
+
+            const auto rotated = std::move(m_rotated.front());
+            m_rotated.erase(m_rotated.begin());
+            lock.unlock();
+
+            if (m_policy.compress) {
+                compress(rotated);
+            }
+            enforce_retention();
+            lock.lock();
+        }
+    }
+
+    /**
+     * Replaces a rotated log with "<log>.z", written to a temporary file
+     * first so a crash never leaves a truncated archive behind.
+     */
+    static bool compress(const std::filesystem::path& path) {
+        QFile in(QString::fromStdString(path.string()));
+        if (!in.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        const QByteArray& packed = qCompress(in.readAll());
+        in.close();
+
+        auto packed_path = path;
+        packed_path += session_log::compressed_suffix;
+        auto temp_path = packed_path;
+        temp_path += ".tmp";
+
+        QFile out(QString::fromStdString(temp_path.string()));
+        if (packed.isEmpty() || !out.open(QIODevice::WriteOnly | QIODevice::Truncate) || out.write(packed) != packed.size() || !out.flush()) {
+            out.remove();
+            return false;
+        }
+        out.close();
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, packed_path, ec);
+        if (ec) {
+            return false;
+        }
+        std::filesystem::rename(session_log::index_path(path), session_log::index_path(packed_path), ec);
+        std::filesystem::remove(path, ec);
+        return true;
+    }
+
+    void enforce_retention() {
+        if (m_policy.retention == 0) {
+            return;
+        }
+
+        std::error_code ec;
+        std::vector<std::pair<std::filesystem::path, std::uint64_t>> files;
+        std::uint64_t total = 0;
+        for (auto& file : session_log::rotated_files(m_log_path)) {
+            // Gone since it was listed, a failed size would count as 2^64 - 1 bytes.
+            auto size = std::filesystem::file_size(file, ec);
+            if (ec) {
+                continue;
+            }
+            if (const auto& index_size = std::filesystem::file_size(session_log::index_path(file), ec); !ec) {
+                size += index_size;
+            }
+            total += size;
+            files.emplace_back(std::move(file), size);
+        }
+
+        for (auto it = files.begin(); it != files.end() && total > m_policy.retention; ++it) {
+            std::filesystem::remove(it->first, ec);
+            std::filesystem::remove(session_log::index_path(it->first), ec);
+            total -= it->second;
+        }
+    }
+
+    void flush() {
+        const auto& count = m_log_output.pending();
+        if (m_log_output.flush(ProcessWatcher::name(m_segment.game))) {
+            m_written.fetch_add(count, std::memory_order_relaxed);
+            m_blocks.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_last_flush = std::chrono::steady_clock::now();
+    }
 };
 }  // namespace vnepogodin
 
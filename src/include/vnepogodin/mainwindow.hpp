@@ -20,7 +20,9 @@
 #define MAINWINDOW_HPP_
 
 #include <ui_mainwindow.h>
+#include <vnepogodin/frame_scheduler.hpp>
 #include <vnepogodin/recorder.hpp>
+#include <vnepogodin/stats_publisher.hpp>
 
 #include <array>
 #include <memory>
@@ -30,6 +32,7 @@
 #include <QMenu>
 #include <QProcess>
 #include <QSystemTrayIcon>
+#include <QTimer>
 
 namespace vnepogodin {
 class MainWindow final : public QMainWindow {
@@ -46,11 +49,16 @@ class MainWindow final : public QMainWindow {
     void closeEvent(QCloseEvent*) override;
 
  private:
+    static constexpr int heatmap_save_interval_ms = 60000;
+
     std::thread m_uiohock;
 
     std::array<std::uint8_t, 2> m_activated{};
 
     std::unique_ptr<vnepogodin::Recorder> m_recorder;
+    std::unique_ptr<vnepogodin::FrameScheduler> m_frame_scheduler;
+    std::unique_ptr<vnepogodin::StatsPublisher> m_stats_publisher;
+    QTimer m_heatmap_timer;
 
     std::unique_ptr<QSystemTrayIcon> m_tray_icon;
     std::unique_ptr<QMenu> m_tray_menu;
@@ -59,6 +67,8 @@ class MainWindow final : public QMainWindow {
     std::unique_ptr<Ui::MainWindow> m_ui = std::make_unique<Ui::MainWindow>();
 
     void createMenu() noexcept;
+    void saveHeatmap();
+    void dumpLatency();
 };
 }  // namespace vnepogodin
 
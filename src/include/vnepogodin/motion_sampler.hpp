@@ -0,0 +1,122 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef MOTION_SAMPLER_HPP
+#define MOTION_SAMPLER_HPP
+
+#include <vnepogodin/event_clock.hpp>
+#include <vnepogodin/seqlock.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace vnepogodin {
+/* Mouse motion folded over one sampling interval */
+struct motion_sample {
+    /* Net displacement in pixels */
+    std::int32_t dx{};
+    std::int32_t dy{};
+    /* Distance travelled along the raw events, in pixels */
+    float path{};
+    /* Peak speed between two raw events, in pixels per second */
+    float max_speed{};
+    /* Raw motion events folded into this sample */
+    std::uint32_t events{};
+    /* event_clock nanoseconds of the first and last raw event */
+    std::int64_t begin{};
+    std::int64_t end{};
+};
+static_assert(std::is_trivially_copyable<motion_sample>::value, "motion_sample must stay memcpy-able");
+
+/**
+ * Coalesces EVENT_MOUSE_MOVED / EVENT_MOUSE_DRAGGED into one event per
+ * interval, so a 1000 Hz mouse doesn't flood the event bus.
+ *
+ * The forwarded event is the last raw one, stamp included, so its position
+ * and time are exact; the motion in between ends up in the published
+ * motion_sample. The hook's input_data still sees every raw event.
+ *
+ * Only the hook thread writes, so the event bus keeps a single producer.
+ * Motion held back when the mouse stops is forwarded with the next hook
+ * event, but the open interval is published as it grows, so readers of
+ * last() never wait for it.
+ */
+class MotionSampler final {
+ public:
+    static constexpr std::int64_t default_interval_us = 16000;
+
+    MotionSampler() = default;
+
+    /* Must be set before the hook starts, 0 forwards every event */
+    inline void set_interval(const std::int64_t& interval_us) noexcept { m_interval_ns = interval_us * event_clock::ns_per_us; }
+
+    /**
+     * Folds a motion event in.
+     * @return true when the interval closed and out holds the event to forward.
+     */
+    bool add(const timed_event& event, timed_event& out) noexcept;
+
+    /**
+     * Closes the interval early, called before forwarding any other event so
+     * consumers keep seeing events in order.
+     * @return true if motion was pending, out then holds the event to forward.
+     */
+    bool flush(timed_event& out) noexcept;
+
+    /**
+     * Closes the interval if its deadline passed, called before folding in
+     * motion that follows a pause.
+     * @return true if motion was due, out then holds the event to forward.
+     */
+    bool flush_due(const std::int64_t& now_ns, timed_event& out) noexcept;
+
+    /* event_clock time the open interval closes at, 0 if no motion is pending */
+    inline std::int64_t deadline() const noexcept { return m_has_pending ? m_current.begin + m_interval_ns : 0; }
+
+    /* Latest sample, the open one while motion is held back. Safe from any thread */
+    inline motion_sample last() const noexcept { return m_published.load(); }
+
+    /* Changes with every folded in event */
+    inline std::uint64_t version() const noexcept { return m_published.version(); }
+
+ private:
+    std::int64_t m_interval_ns{default_interval_us * event_clock::ns_per_us};
+
+    /* Writer only */
+    motion_sample m_current{};
+    timed_event m_pending{};
+    bool m_has_pending{};
+    bool m_has_position{};
+    std::int16_t m_x{};
+    std::int16_t m_y{};
+    std::int64_t m_last_time{};
+    /* Distance since the last event with a distinct timestamp */
+    float m_unclocked_path{};
+
+    seqlock<motion_sample> m_published;
+
+    void close() noexcept;
+};
+}  // namespace vnepogodin
+
+namespace local_data {
+/* Fed straight from the hook thread */
+extern vnepogodin::MotionSampler motion;
+}  // namespace local_data
+
+#endif  // MOTION_SAMPLER_HPP
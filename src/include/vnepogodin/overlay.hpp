@@ -21,9 +21,14 @@
 
 #include <ui_overlay.h>
 #include <vnepogodin/input_data.hpp>
+#include <vnepogodin/key_layout.hpp>
+#include <vnepogodin/latency_tracer.hpp>
+#include <vnepogodin/sprite_cache.hpp>
+#include <vnepogodin/uiohook_helper.hpp>
 
-#include <thread>
+#include <string_view>
 
+#include <QRegion>
 #include <QWidget>
 
 namespace Ui {
@@ -38,27 +43,80 @@ class Overlay : public QWidget {
     explicit Overlay(QWidget* parent = nullptr);
     virtual ~Overlay();
 
+    /* Events the overlay missed because it fell a whole event bus behind */
+    inline std::uint64_t droppedEvents() const noexcept { return cursor.dropped(); }
+
+ public slots:
+    /**
+     * Consumes pending input and schedules a repaint of the keys that
+     * changed since the last frame.
+     */
+    void refresh();
+
  protected:
     /**
      * Overloads default paint constructor in order to render overlay's svgs.
      */
     void paintEvent(QPaintEvent*) override;
 
+    /**
+     * Drops cached rasterized assets, since they depend on the widget size.
+     */
+    void resizeEvent(QResizeEvent*) override;
+
     /**
      * Paints a svg asset with a transparent background.
+     * The asset is rasterized once and then served from the sprite cache.
      */
-    void paintAsset(std::string name, const QPoint& place, QPaintDevice* device, const double& scale);
+    void paintAsset(const std::string_view& name, const QPoint& place, QPaintDevice* device, const double& scale);
+
+    /**
+     * @return rectangle a svg asset covers on the widget.
+     */
+    QRect assetRect(const std::string_view& name, const QPoint& place, const double& scale);
+
+    /**
+     * @return widget position of a point given in base svg coordinates.
+     */
+    static QPoint placeAsset(const QPoint& pos, const QPoint& corner, const double& scale) noexcept;
+
+    /**
+     * @return input state the current frame is painted from.
+     */
+    inline const input_snapshot& state() const noexcept { return m_state; }
 
  private:
     /** Private Members */
-    bool connected                    = false;
-    static constexpr int refresh_rate = 600;  // Frequency of input checking in hertz
-    std::thread poll;
+    bool connected = false;
+
+    /* Base svg rasterized at the widget size */
+    QImage m_base;
+    QSize m_base_size{};
+    SpriteCache m_sprites;
+
+    std::unique_ptr<input_data> handler = std::make_unique<input_data>();
+    uiohook::event_queue::cursor cursor = uiohook::buf.subscribe();
+
+    /* State shown on screen and the region being repainted */
+    input_snapshot m_state{};
+    QRegion m_paint_region;
+
+    /* Presses and releases waiting for the next paint */
+    LatencyTracer::pending_t m_traces;
 
     std::unique_ptr<Ui::Overlay> ui = std::make_unique<Ui::Overlay>();
 
     virtual const char* getSvgPath() const noexcept = 0;
 
+    /* Device whose buttons the overlay shows */
+    virtual layout::device inputDevice() const noexcept = 0;
+
+    /**
+     * @return true if the event presses or releases one of the
+     * overlay's buttons, those are followed until painted.
+     */
+    bool isTraced(const uiohook_event& event) const noexcept;
+
     /**
      * Tries to connect to device.
      * @return true if device is connected and false if no connection can be
@@ -66,12 +124,23 @@ class Overlay : public QWidget {
      */
     bool connect() noexcept;
 
+    /**
+     * Rasterizes base (or disconnected) svg to the current widget size.
+     */
+    void renderBase();
+
     /**
      * Helper function for paintEvent that paints buttons that are
      * on.
      */
     virtual void paintButtons(QPaintDevice* device, const QPoint& corner, const double& scale) = 0;
 
+    /**
+     * @return area covered by buttons whose state differs between both
+     * snapshots.
+     */
+    virtual QRegion changedRegion(const input_snapshot& before, const input_snapshot& after, const QPoint& corner, const double& scale) = 0;
+
     /**
      * Helper function for paintEvent that paints device's features
      * that are on.
@@ -93,11 +162,6 @@ class Overlay : public QWidget {
      * @return Locates the corner point of the base svg on the widget.
      */
     QPoint locateCorner(const QSize& defaultSize, const QSize& viewBox);
-
-    /**
-     * Calls repaint on a thread for the specified refresh rate.
-     */
-    void paintLoop();
 };
 }  // namespace vnepogodin
 
@@ -33,16 +33,18 @@ class OverlayKeyboard final : public Overlay {
 
  private:
     /** Private Members */
-    std::mutex data_mutex;
-
-    std::unique_ptr<input_data> handler = std::make_unique<input_data>();
-
     const char* getSvgPath() const noexcept override;
+    layout::device inputDevice() const noexcept override;
 
     /**
     * Helper function for paintEvent that paints buttons that are on.
     */
     void paintButtons(QPaintDevice* device, const QPoint& corner, const double& scale) override;
+
+    /**
+    * Area of the buttons which were pressed or released between both snapshots.
+    */
+    QRegion changedRegion(const input_snapshot& before, const input_snapshot& after, const QPoint& corner, const double& scale) override;
 };
 }  // namespace vnepogodin
 
@@ -0,0 +1,115 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef PROCESS_WATCHER_HPP
+#define PROCESS_WATCHER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace vnepogodin {
+namespace detail {
+    struct tracked_game {
+        /* Executable name, without the directory */
+        std::string_view exe;
+        std::string_view name;
+    };
+
+    /* clang-format off */
+#ifdef _WIN32
+    static constexpr std::array tracked_games = {
+        tracked_game{"dota.exe",     "Dota"},
+        tracked_game{"csgo.exe",     "Counter-Strike: Global Offensive"},
+        tracked_game{"lol.exe",      "League of Legends"},
+        tracked_game{"fortnite.exe", "Fortnite"},
+    };
+#else
+    static constexpr std::array tracked_games = {
+        tracked_game{"dota", "Dota"},
+        tracked_game{"csgo", "Counter-Strike: Global Offensive"},
+    };
+#endif
+    /* clang-format on */
+}  // namespace detail
+
+/**
+ * Keeps track of which tracked game is running.
+ *
+ * Every process is examined once, when it first shows up; afterwards
+ * refresh() only lists pids, so it stays cheap with thousands of processes.
+ * On Linux a process is identified by pid and start time. The start time is
+ * only read when a pid is new or its /proc entry changed inode, a reused pid
+ * is examined again. Windows can't tell a reused pid apart.
+ * refresh() must be called from a single thread, current() from any.
+ */
+class ProcessWatcher final {
+ public:
+    using game_index_t                        = std::uint8_t;
+    static constexpr game_index_t npos        = 0xFF;
+    static constexpr std::string_view unknown = "Unknown process";
+
+    ProcessWatcher() = default;
+
+    /**
+     * Picks up started and exited processes.
+     * @return true if the running game changed.
+     */
+    bool refresh();
+
+    /**
+     * Position in detail::tracked_games, npos if no game is running.
+     */
+    inline game_index_t current() const noexcept { return m_current.load(std::memory_order_acquire); }
+
+    inline std::string_view current_name() const noexcept { return name(current()); }
+
+    static constexpr std::string_view name(const game_index_t& game) noexcept {
+        return (game < detail::tracked_games.size()) ? detail::tracked_games[game].name : unknown;
+    }
+
+ private:
+    struct process_info {
+        /* Inode of /proc/<pid> as listed, a new one hints at a reused pid */
+        std::uint64_t inode{};
+        /* Kernel start time, tells a reused pid apart. Always 0 on Windows */
+        std::uint64_t start{};
+        game_index_t game{npos};
+        /* Last refresh the pid was listed in */
+        std::uint64_t seen{};
+    };
+
+    std::unordered_map<std::uint32_t, process_info> m_processes;
+    std::array<std::uint32_t, detail::tracked_games.size()> m_running{};
+    std::uint64_t m_epoch{};
+    std::atomic<game_index_t> m_current{npos};
+
+    /**
+     * Called for every listed pid, start time and exe are only looked at when
+     * the pid is new or inode changed. start_proc returns nullopt once the
+     * process is gone.
+     */
+    template <class StartProc, class ExeProc>
+    void visit(const std::uint32_t& pid, const std::uint64_t& inode, StartProc&& start_proc, ExeProc&& exe_proc);
+    void sweep();
+};
+}  // namespace vnepogodin
+
+#endif  // PROCESS_WATCHER_HPP
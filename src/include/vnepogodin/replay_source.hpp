@@ -0,0 +1,66 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef REPLAY_SOURCE_HPP
+#define REPLAY_SOURCE_HPP
+
+#include <vnepogodin/event_clock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace vnepogodin {
+/**
+ * Event streams for overlay-replay.
+ *
+ * time_ns of each event is its offset from the start of the stream, the
+ * replay turns it back into wall-clock pacing.
+ */
+namespace replay_source {
+    using stream = std::vector<timed_event>;
+
+    /**
+     * Key presses and releases recorded in a session log, rotated logs
+     * (".z") included. Only tracked keys are logged, so there's no motion.
+     * @return empty if the log can't be read.
+     */
+    stream load_log(const std::filesystem::path& path);
+
+    /* What synthesize() generates */
+    struct synthetic_options {
+        /* Events in the stream */
+        std::size_t count{100000};
+        /* Mouse motion per second, 0 for keys only */
+        std::uint32_t motion_rate{1000};
+        /* Key and button presses per second, each followed by its release */
+        std::uint32_t press_rate{20};
+        std::uint32_t seed{1};
+    };
+
+    /**
+     * Deterministic stream of motion and presses on the tracked keys, the
+     * same options always give the same events.
+     */
+    stream synthesize(const synthetic_options& options);
+}  // namespace replay_source
+}  // namespace vnepogodin
+
+#endif  // REPLAY_SOURCE_HPP
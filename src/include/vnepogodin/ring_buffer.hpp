@@ -0,0 +1,106 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace vnepogodin {
+static constexpr std::size_t cache_line_size = 64;
+
+/**
+ * Fixed-capacity lock-free single-producer/single-consumer queue.
+ *
+ * Producer and consumer indices live on separate cache lines, so the hook
+ * thread and the GUI thread never false-share. When the queue is full
+ * push() drops the value and bumps the dropped counter instead of blocking.
+ */
+template <class T, std::size_t Capacity>
+class ring_buffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+ public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    ring_buffer()                   = default;
+    ring_buffer(const ring_buffer&) = delete;
+    ring_buffer& operator=(const ring_buffer&) = delete;
+
+    /* Producer side */
+    bool push(const value_type& value) noexcept {
+        const auto& head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail_cache == Capacity) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tail_cache == Capacity) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        m_data[head & mask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer side */
+    bool pop(value_type& value) noexcept {
+        const auto& tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head_cache) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail == m_head_cache) {
+                return false;
+            }
+        }
+
+        value = m_data[tail & mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Approximate when called concurrently with push/pop */
+    inline size_type size() const noexcept {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+    inline bool empty() const noexcept { return size() == 0; }
+    static constexpr size_type capacity() noexcept { return Capacity; }
+
+    /* Number of values rejected because the queue was full */
+    inline std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+ private:
+    static constexpr size_type mask = Capacity - 1;
+
+    alignas(cache_line_size) std::atomic<size_type> m_head{};
+    size_type m_tail_cache{};
+    std::atomic<std::uint64_t> m_dropped{};
+
+    alignas(cache_line_size) std::atomic<size_type> m_tail{};
+    size_type m_head_cache{};
+
+    alignas(cache_line_size) std::array<value_type, Capacity> m_data{};
+};
+}  // namespace vnepogodin
+
+#endif  // RING_BUFFER_HPP
@@ -0,0 +1,114 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace vnepogodin {
+
+/**
+ * Single-writer sequence lock.
+ *
+ * The writer never waits, readers retry until they observe a stable copy.
+ * The payload is kept in relaxed atomic words, so concurrent reads and
+ * writes are well defined and a torn copy is always detected by the
+ * sequence check.
+ */
+template <class T>
+class seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+
+    using word_type                         = std::uint64_t;
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(word_type) - 1) / sizeof(word_type);
+    using words_type                        = std::array<word_type, word_count>;
+
+ public:
+    using value_type = T;
+
+    seqlock() = default;
+    explicit seqlock(const value_type& value) noexcept { store(value); }
+
+    seqlock(const seqlock&) = delete;
+    seqlock& operator=(const seqlock&) = delete;
+
+    /* Writer side, must only be called from a single thread */
+    void store(const value_type& value) noexcept {
+        words_type words{};
+        std::memcpy(words.data(), &value, sizeof(value_type));
+
+        const auto& seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < word_count; ++i) {
+            m_data[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /* Reader side, safe from any number of threads */
+    value_type load() const noexcept {
+        value_type result{};
+        while (!try_load(result)) { }
+        return result;
+    }
+
+    /**
+     * Like load(), but gives up after a few attempts instead of waiting
+     * for a writer that may never finish, e.g. one in a crashed process.
+     */
+    bool try_load(value_type& result, std::size_t attempts = 64) const noexcept {
+        words_type words{};
+        for (; attempts > 0; --attempts) {
+            const auto& before = m_seq.load(std::memory_order_acquire);
+            if (before & 1U) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < word_count; ++i) {
+                words[i] = m_data[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) == before) {
+                std::memcpy(static_cast<void*>(&result), words.data(), sizeof(value_type));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Bumped by every store, lets readers skip work when nothing changed */
+    inline std::uint64_t version() const noexcept {
+        return m_seq.load(std::memory_order_acquire) / 2;
+    }
+
+ private:
+    std::atomic<std::uint64_t> m_seq{};
+    std::array<std::atomic<word_type>, word_count> m_data{};
+};
+}  // namespace vnepogodin
+
+#endif  // SEQLOCK_HPP
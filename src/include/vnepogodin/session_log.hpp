@@ -0,0 +1,855 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef SESSION_LOG_HPP
+#define SESSION_LOG_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <uiohook.h>
+
+/**
+ * Binary key log.
+ *
+ * Layout (little-endian):
+ *   file_header
+ *   (block | segment)*
+ *
+ *   block, one per flush:
+ *     block_header
+ *     name       char[name_size]
+ *     time_delta uint32[count]  milliseconds since the previous record
+ *     fraction   uint32[count]  nanoseconds past the record's millisecond (version 3+)
+ *     key        uint8[count]   index into vnepogodin::layout::keys
+ *     type       uint8[count]   uiohook event_type
+ *
+ *   segment, written when the running game changes (version 2+):
+ *     segment_header
+ *     name       char[name_size]
+ *
+ * Blocks are only ever appended; a block cut short by a crash is ignored
+ * by the reader, everything flushed before it stays readable. The writer
+ * cuts such a block off before appending again.
+ *
+ * "<log>.idx" next to the log holds one index_entry per chunk, so readers
+ * can aggregate or skip whole blocks without touching their records.
+ */
+namespace vnepogodin {
+namespace session_log {
+    static constexpr std::array<char, 4> file_magic = {'G', 'T', 'K', 'L'};
+    static constexpr std::uint32_t block_magic      = 0x4B434C42;  // "BLCK"
+    static constexpr std::uint32_t segment_magic    = 0x544D4753;  // "SGMT"
+    static constexpr std::uint16_t version          = 3;
+
+    struct file_header {
+        std::array<char, 4> magic{file_magic};
+        std::uint16_t version{session_log::version};
+        std::uint16_t reserved{};
+    };
+    static_assert(sizeof(file_header) == 8 && std::is_trivially_copyable<file_header>::value);
+
+    struct block_header {
+        std::uint32_t magic{block_magic};
+        std::uint32_t count{};
+        /* Unix time of the first record, in milliseconds */
+        std::int64_t base_time{};
+        std::uint16_t name_size{};
+        std::uint16_t reserved{};
+        std::uint32_t reserved2{};
+    };
+    static_assert(sizeof(block_header) == 24 && std::is_trivially_copyable<block_header>::value);
+
+    /* A stretch of time spent in one game */
+    struct segment_header {
+        std::uint32_t magic{segment_magic};
+        /* Records logged during the segment */
+        std::uint32_t count{};
+        /* Unix time in milliseconds */
+        std::int64_t start_time{};
+        std::int64_t end_time{};
+        std::uint16_t name_size{};
+        std::uint16_t reserved{};
+        std::uint32_t reserved2{};
+    };
+    static_assert(sizeof(segment_header) == 32 && std::is_trivially_copyable<segment_header>::value);
+
+    struct segment {
+        std::int64_t start_time{};
+        std::int64_t end_time{};
+        std::uint32_t count{};
+        std::string name{};
+    };
+
+    enum class chunk_type : std::uint8_t {
+        none,
+        block,
+        segment
+    };
+
+    /* Where the overlay's logger writes */
+    inline std::filesystem::path default_path() {
+        std::error_code ec;
+        const auto& dir = std::filesystem::temp_directory_path(ec);
+        return (ec ? std::filesystem::path(".") : dir) / "goattech_keys.bin";
+    }
+
+    /* Decoded record */
+    struct record {
+        /* Unix time in nanoseconds, to the millisecond before version 3 */
+        std::int64_t time{};
+        std::uint8_t key{};
+        std::uint8_t type{};
+    };
+
+    namespace detail {
+        template <class T>
+        inline void write_pod(std::ostream& out, const T& value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <class T>
+        inline void write_column(std::ostream& out, const std::vector<T>& column) {
+            out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(T)));
+        }
+
+        template <class T>
+        inline bool read_pod(std::istream& in, T& value) {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        template <class T>
+        inline bool read_column(std::istream& in, std::vector<T>& column, const std::size_t& count) {
+            column.resize(count);
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(count * sizeof(T))));
+        }
+
+        /* Files are only appended to in the current version */
+        inline bool writable_header(const file_header& header) noexcept {
+            return header.magic == file_magic && header.version == version;
+        }
+
+        inline bool readable_header(const file_header& header) noexcept {
+            return header.magic == file_magic && header.version >= 1 && header.version <= version;
+        }
+
+        /* Bytes per record across a block's columns */
+        inline std::size_t record_size(const std::uint16_t& file_version) noexcept {
+            return (file_version >= 3) ? 2 * sizeof(std::uint32_t) + 2 : sizeof(std::uint32_t) + 2;
+        }
+
+        static constexpr std::int64_t ns_per_ms = 1000000;
+    }  // namespace detail
+
+    /* Block read in place from a buffer, columns are unaligned */
+    struct block_view {
+        std::int64_t base_time{};
+        std::string_view name{};
+        std::uint32_t count{};
+        const char* time_delta{};
+        /* nullptr before version 3 */
+        const char* fraction{};
+        const char* key{};
+        const char* type{};
+
+        inline std::uint32_t delta_at(const std::size_t& i) const noexcept {
+            std::uint32_t value{};
+            std::memcpy(&value, time_delta + i * sizeof(value), sizeof(value));
+            return value;
+        }
+        inline std::uint32_t fraction_at(const std::size_t& i) const noexcept {
+            std::uint32_t value{};
+            if (fraction != nullptr) {
+                std::memcpy(&value, fraction + i * sizeof(value), sizeof(value));
+            }
+            return value;
+        }
+        inline std::uint8_t key_at(const std::size_t& i) const noexcept { return static_cast<std::uint8_t>(key[i]); }
+        inline std::uint8_t type_at(const std::size_t& i) const noexcept { return static_cast<std::uint8_t>(type[i]); }
+    };
+
+    struct segment_view {
+        std::int64_t start_time{};
+        std::int64_t end_time{};
+        std::uint32_t count{};
+        std::string_view name{};
+    };
+
+    /**
+     * Walks a log held in memory, e.g. a mapped file, without copying.
+     * Stops at the first incomplete chunk, position() then tells where
+     * to resume once the file has grown.
+     */
+    class buffer_reader final {
+     public:
+        buffer_reader(const char* data, const std::size_t& size) noexcept : m_data(data), m_size(size) {
+            file_header header{};
+            m_valid   = read_at(0, header) && detail::readable_header(header);
+            m_version = header.version;
+            m_pos     = sizeof(file_header);
+        }
+
+        inline bool valid() const noexcept { return m_valid; }
+
+        /* Offset just past the last complete chunk */
+        inline std::size_t position() const noexcept { return m_pos; }
+
+        /* Resumes at an offset previously returned by position() */
+        inline void seek(const std::size_t& pos) noexcept { m_pos = std::max(pos, sizeof(file_header)); }
+
+        chunk_type next(block_view& out_block, segment_view& out_segment) noexcept {
+            std::uint32_t magic{};
+            if (!m_valid || !read_at(m_pos, magic)) {
+                return chunk_type::none;
+            }
+
+            if (magic == block_magic) {
+                block_header header{};
+                if (!read_at(m_pos, header)) {
+                    return chunk_type::none;
+                }
+                const std::size_t& count = header.count;
+                const auto& size         = sizeof(header) + header.name_size + count * detail::record_size(m_version);
+                if (m_size - m_pos < size) {
+                    return chunk_type::none;
+                }
+
+                const char* ptr      = m_data + m_pos + sizeof(header);
+                out_block.base_time  = header.base_time;
+                out_block.name       = {ptr, header.name_size};
+                out_block.count      = header.count;
+                out_block.time_delta = ptr + header.name_size;
+                out_block.fraction   = (m_version >= 3) ? out_block.time_delta + count * sizeof(std::uint32_t) : nullptr;
+                out_block.key        = (out_block.fraction != nullptr ? out_block.fraction : out_block.time_delta) + count * sizeof(std::uint32_t);
+                out_block.type       = out_block.key + count;
+                m_pos += size;
+                return chunk_type::block;
+            }
+
+            if (magic == segment_magic) {
+                segment_header header{};
+                if (!read_at(m_pos, header) || m_size - m_pos < sizeof(header) + header.name_size) {
+                    return chunk_type::none;
+                }
+
+                out_segment.start_time = header.start_time;
+                out_segment.end_time   = header.end_time;
+                out_segment.count      = header.count;
+                out_segment.name       = {m_data + m_pos + sizeof(header), header.name_size};
+                m_pos += sizeof(header) + header.name_size;
+                return chunk_type::segment;
+            }
+            return chunk_type::none;
+        }
+
+     private:
+        const char* m_data{};
+        std::size_t m_size{};
+        std::size_t m_pos{};
+        std::uint16_t m_version{};
+        bool m_valid{};
+
+        template <class T>
+        inline bool read_at(const std::size_t& pos, T& value) const noexcept {
+            if (pos > m_size || m_size - pos < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, m_data + pos, sizeof(T));
+            return true;
+        }
+    };
+
+    static constexpr std::array<char, 4> index_magic = {'G', 'T', 'K', 'I'};
+    static constexpr std::uint32_t entry_magic       = 0x45584449;  // "IDXE"
+    static constexpr std::uint16_t index_version     = 1;
+    /* Press counters per entry, indexed like the records' key column */
+    static constexpr std::size_t index_key_slots = 32;
+
+    /* The sidecar index lives next to the log */
+    inline std::filesystem::path index_path(const std::filesystem::path& log_path) {
+        auto result = log_path;
+        return result += ".idx";
+    }
+
+    /* When the logger starts a new file and how much rotated history it keeps */
+    struct rotation_policy {
+        /* Rotate once the log reaches this size or age */
+        std::uint64_t max_size{16ULL << 20U};
+        std::chrono::hours max_age{24};
+        /* Rotated logs past this many bytes are deleted, oldest first; 0 keeps all */
+        std::uint64_t retention{256ULL << 20U};
+        bool compress{true};
+    };
+
+    /* Suffix of rotated logs compressed with zlib (qCompress framing) */
+    static constexpr std::string_view compressed_suffix = ".z";
+
+    /* Where a full log is moved on rotation, "<stem>-<unix ms><ext>" */
+    inline std::filesystem::path rotated_path(const std::filesystem::path& log_path, const std::int64_t& time) {
+        auto result = log_path;
+        return result.replace_filename(log_path.stem().string() + "-" + std::to_string(time) + log_path.extension().string());
+    }
+
+    /**
+     * Logs rotated away from log_path, compressed or not, oldest first.
+     */
+    inline std::vector<std::filesystem::path> rotated_files(const std::filesystem::path& log_path) {
+        const auto& prefix    = log_path.stem().string() + "-";
+        const auto& extension = log_path.extension().string();
+
+        std::vector<std::pair<std::int64_t, std::filesystem::path>> found;
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(log_path.parent_path(), ec), end; !ec && it != end; it.increment(ec)) {
+            const auto& filename  = it->path().filename().string();
+            std::string_view name = filename;
+            if (name.size() > compressed_suffix.size() && name.substr(name.size() - compressed_suffix.size()) == compressed_suffix) {
+                name.remove_suffix(compressed_suffix.size());
+            }
+            if (name.size() <= prefix.size() + extension.size() || name.substr(0, prefix.size()) != prefix
+                || name.substr(name.size() - extension.size()) != extension) {
+                continue;
+            }
+
+            const auto& stamp = name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+            std::int64_t time{};
+            if (const auto& [ptr, err] = std::from_chars(stamp.data(), stamp.data() + stamp.size(), time); err == std::errc{} && ptr == stamp.data() + stamp.size()) {
+                found.emplace_back(time, it->path());
+            }
+        }
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::filesystem::path> result;
+        result.reserve(found.size());
+        for (auto& [time, path] : found) {
+            result.push_back(std::move(path));
+        }
+        return result;
+    }
+
+    /**
+     * Summary of one log chunk.
+     *
+     * Entries are appended as chunks are written. Each one carries a
+     * checksum, so a torn append after a crash is found and dropped on the
+     * next open.
+     */
+    struct index_entry {
+        std::uint32_t magic{entry_magic};
+        /* CRC-32 of the rest of the entry, name included */
+        std::uint32_t checksum{};
+        /* Where the chunk starts in the log and how long it is */
+        std::uint64_t offset{};
+        std::uint32_t size{};
+        std::uint32_t count{};
+        /* Unix time in milliseconds */
+        std::int64_t first_time{};
+        std::int64_t last_time{};
+        std::array<std::uint32_t, index_key_slots> presses{};
+        chunk_type type{};
+        std::uint8_t reserved{};
+        std::uint16_t name_size{};
+        std::uint32_t reserved2{};
+    };
+    static_assert(sizeof(index_entry) == 176 && std::is_trivially_copyable<index_entry>::value);
+
+    namespace detail {
+        constexpr std::array<std::uint32_t, 256> make_crc32_table() noexcept {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < table.size(); ++i) {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc & 1U) ? (crc >> 1U) ^ 0xEDB88320U : crc >> 1U;
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+        static constexpr auto crc32_table = make_crc32_table();
+
+        inline std::uint32_t crc32(const char* data, const std::size_t& size, std::uint32_t crc = 0) noexcept {
+            crc = ~crc;
+            for (std::size_t i = 0; i < size; ++i) {
+                crc = crc32_table[(crc ^ static_cast<std::uint8_t>(data[i])) & 0xFFU] ^ (crc >> 8U);
+            }
+            return ~crc;
+        }
+
+        inline std::uint32_t entry_checksum(const index_entry& entry, const std::string_view& name) noexcept {
+            static constexpr std::size_t skip = sizeof(entry.magic) + sizeof(entry.checksum);
+            const auto& crc = crc32(reinterpret_cast<const char*>(&entry) + skip, sizeof(entry) - skip);
+            return crc32(name.data(), name.size(), crc);
+        }
+
+        inline bool is_press(const std::uint8_t& type) noexcept {
+            return type == EVENT_KEY_PRESSED || type == EVENT_MOUSE_PRESSED;
+        }
+    }  // namespace detail
+
+    inline index_entry make_entry(const block_view& block, const std::uint64_t& offset, const std::uint32_t& size) noexcept {
+        index_entry entry{};
+        entry.type       = chunk_type::block;
+        entry.offset     = offset;
+        entry.size       = size;
+        entry.count      = block.count;
+        entry.name_size  = static_cast<std::uint16_t>(block.name.size());
+        entry.first_time = block.base_time;
+
+        std::int64_t time = block.base_time;
+        for (std::size_t i = 0; i < block.count; ++i) {
+            time += block.delta_at(i);
+            if (block.key_at(i) < index_key_slots && detail::is_press(block.type_at(i))) {
+                ++entry.presses[block.key_at(i)];
+            }
+        }
+        entry.last_time = time;
+        return entry;
+    }
+
+    inline index_entry make_entry(const segment_view& segment, const std::uint64_t& offset, const std::uint32_t& size) noexcept {
+        index_entry entry{};
+        entry.type       = chunk_type::segment;
+        entry.offset     = offset;
+        entry.size       = size;
+        entry.count      = segment.count;
+        entry.name_size  = static_cast<std::uint16_t>(segment.name.size());
+        entry.first_time = segment.start_time;
+        entry.last_time  = segment.end_time;
+        return entry;
+    }
+
+    /**
+     * Sequential sidecar reader, stops at the first damaged entry.
+     */
+    class index_reader final {
+     public:
+        explicit index_reader(const std::filesystem::path& path) : m_in(path, std::ios::binary) {
+            file_header header{};
+            m_valid = detail::read_pod(m_in, header) && header.magic == index_magic && header.version == index_version;
+        }
+
+        inline bool valid() const noexcept { return m_valid; }
+
+        bool next(index_entry& entry, std::string& name) {
+            if (!m_valid || !detail::read_pod(m_in, entry) || entry.magic != entry_magic) {
+                return false;
+            }
+            name.resize(entry.name_size);
+            if (!m_in.read(name.data(), static_cast<std::streamsize>(entry.name_size))) {
+                return false;
+            }
+            return entry.checksum == detail::entry_checksum(entry, name);
+        }
+
+        /* Offset just past the last entry read */
+        inline std::uint64_t position() { return static_cast<std::uint64_t>(m_in.tellg()); }
+
+     private:
+        std::ifstream m_in;
+        bool m_valid{};
+    };
+
+    /**
+     * Appends entries to the sidecar index and keeps it in step with the log.
+     */
+    class index_writer final {
+     public:
+        index_writer() = default;
+
+        /**
+         * Drops damaged entries from the tail, then indexes log chunks the
+         * index doesn't know about yet, e.g. after a crash between the two
+         * appends or when the index is missing. log_end() then tells where
+         * the last complete chunk of the log ends.
+         */
+        bool open(const std::filesystem::path& log_path) {
+            const auto& path = index_path(log_path);
+
+            std::uint64_t good_size = 0;
+            std::uint64_t log_end   = sizeof(file_header);
+            if (index_reader in(path); in.valid()) {
+                good_size = sizeof(file_header);
+
+                index_entry entry{};
+                std::string name;
+                while (in.next(entry, name)) {
+                    good_size = in.position();
+                    log_end   = std::max<std::uint64_t>(log_end, entry.offset + entry.size);
+                }
+            }
+
+            // The log was replaced under the index, start over.
+            std::error_code size_ec;
+            const auto& log_size = std::filesystem::file_size(log_path, size_ec);
+            if (size_ec || log_size < log_end) {
+                good_size = 0;
+                log_end   = sizeof(file_header);
+            }
+
+            // A tail that can't be cut off would sit between entries, index the whole log again instead.
+            std::error_code resize_ec;
+            if (good_size != 0) {
+                std::filesystem::resize_file(path, good_size, resize_ec);
+            }
+            if (good_size == 0 || resize_ec) {
+                std::ofstream fresh(path, std::ios::binary | std::ios::trunc);
+                detail::write_pod(fresh, file_header{index_magic, index_version, 0});
+                log_end = sizeof(file_header);
+            }
+
+            m_out.open(path, std::ios::binary | std::ios::app);
+            m_log_end = log_end;
+            if (!size_ec && log_size > log_end) {
+                catch_up(log_path, log_end);
+            }
+            return static_cast<bool>(m_out);
+        }
+
+        /* Offset just past the last complete chunk of the log, set by open() */
+        inline std::uint64_t log_end() const noexcept { return m_log_end; }
+
+        bool add(index_entry entry, const std::string_view& name) {
+            if (!m_out) {
+                return false;
+            }
+
+            entry.name_size = static_cast<std::uint16_t>(name.size());
+            entry.checksum  = detail::entry_checksum(entry, name);
+            detail::write_pod(m_out, entry);
+            m_out.write(name.data(), static_cast<std::streamsize>(name.size()));
+            m_out.flush();
+            return static_cast<bool>(m_out);
+        }
+
+        inline void close() { m_out.close(); }
+
+     private:
+        std::ofstream m_out{};
+        std::uint64_t m_log_end{};
+
+        void catch_up(const std::filesystem::path& log_path, const std::uint64_t& from) {
+            std::ifstream in(log_path, std::ios::binary);
+            const std::vector<char> data(std::istreambuf_iterator<char>(in), {});
+
+            buffer_reader log(data.data(), data.size());
+            log.seek(static_cast<std::size_t>(from));
+
+            block_view block{};
+            segment_view segment{};
+            auto offset = log.position();
+            for (chunk_type type{}; (type = log.next(block, segment)) != chunk_type::none; offset = log.position()) {
+                const auto& size = static_cast<std::uint32_t>(log.position() - offset);
+                if (type == chunk_type::block) {
+                    add(make_entry(block, offset, size), block.name);
+                } else {
+                    add(make_entry(segment, offset, size), segment.name);
+                }
+            }
+            m_log_end = log.position();
+        }
+    };
+
+
+    /**
+     * Buffers records in columns and appends them as one block per flush(),
+     * keeping the sidecar index up to date.
+     */
+    class writer final {
+     public:
+        writer() = default;
+
+        /**
+         * Opens the log for appending. A log from an older version is
+         * rotated like a full one, so its history stays readable; an
+         * existing file in another format is moved aside to "<path>.old"
+         * instead of being overwritten.
+         */
+        bool open(const std::filesystem::path& path) {
+            std::error_code ec;
+            if (std::filesystem::exists(path, ec) && std::filesystem::file_size(path, ec) > 0) {
+                std::ifstream in(path, std::ios::binary);
+                file_header header{};
+                const bool& readable = detail::read_pod(in, header) && detail::readable_header(header);
+                if (!readable || !detail::writable_header(header)) {
+                    in.close();
+                    auto old_path = path;
+                    if (readable) {
+                        const auto& time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+                        old_path         = rotated_path(path, time.count());
+                    } else {
+                        old_path += ".old";
+                    }
+                    std::filesystem::rename(path, old_path, ec);
+                    std::filesystem::rename(index_path(path), index_path(old_path), ec);
+                }
+            }
+
+            const bool& fresh = !std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0;
+            if (fresh) {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                detail::write_pod(out, file_header{});
+            }
+
+            // The log is the source of truth, it works without an index.
+            m_index.open(path);
+
+            // Readers stop at a block torn by a crash, anything appended
+            // after it would be lost. Cut the log back to its last complete chunk.
+            if (const auto& size = std::filesystem::file_size(path, ec); !ec && size > m_index.log_end()) {
+                std::filesystem::resize_file(path, m_index.log_end(), ec);
+            }
+
+            m_out.open(path, std::ios::binary | std::ios::app);
+            m_offset = std::filesystem::file_size(path, ec);
+            return static_cast<bool>(m_out);
+        }
+
+        /**
+         * Buffers a record.
+         * @param time is Unix time in nanoseconds, earlier than the previous record counts as simultaneous.
+         */
+        inline void add(const std::int64_t& time, const std::uint8_t& key, const std::uint8_t& type) {
+            if (m_time_delta.empty()) {
+                m_base_time = time / detail::ns_per_ms;
+                m_last_time = time;
+            }
+            const auto& clamped = std::max(time, m_last_time);
+            const auto& delta   = clamped / detail::ns_per_ms - m_last_time / detail::ns_per_ms;
+            m_time_delta.push_back(static_cast<std::uint32_t>(delta));
+            m_fraction.push_back(static_cast<std::uint32_t>(clamped % detail::ns_per_ms));
+            m_key.push_back(key);
+            m_type.push_back(type);
+            m_last_time = clamped;
+        }
+
+        /**
+         * Appends buffered records as a block and flushes the stream.
+         * @param name is the name of the game the block belongs to.
+         */
+        bool flush(const std::string_view& name) {
+            if (m_time_delta.empty() || !m_out) {
+                return false;
+            }
+
+            block_header header{};
+            header.count     = static_cast<std::uint32_t>(m_time_delta.size());
+            header.base_time = m_base_time;
+            header.name_size = static_cast<std::uint16_t>(name.size());
+
+            detail::write_pod(m_out, header);
+            m_out.write(name.data(), static_cast<std::streamsize>(header.name_size));
+            detail::write_column(m_out, m_time_delta);
+            detail::write_column(m_out, m_fraction);
+            detail::write_column(m_out, m_key);
+            detail::write_column(m_out, m_type);
+            m_out.flush();
+
+            // Index only what made it to disk, the entry points at the block.
+            const auto& size = static_cast<std::uint32_t>(sizeof(header) + header.name_size + header.count * detail::record_size(version));
+            if (m_out) {
+                const block_view view{m_base_time, name.substr(0, header.name_size), header.count,
+                    reinterpret_cast<const char*>(m_time_delta.data()), reinterpret_cast<const char*>(m_fraction.data()),
+                    reinterpret_cast<const char*>(m_key.data()), reinterpret_cast<const char*>(m_type.data())};
+                m_index.add(make_entry(view, m_offset, size), view.name);
+                m_offset += size;
+            }
+
+            m_time_delta.clear();
+            m_fraction.clear();
+            m_key.clear();
+            m_type.clear();
+            return static_cast<bool>(m_out);
+        }
+
+        /**
+         * Appends a segment record. Buffered records are not flushed,
+         * call flush() first so they land before the segment.
+         */
+        bool add_segment(const std::int64_t& start_time, const std::int64_t& end_time, const std::uint32_t& count, const std::string_view& name) {
+            if (!m_out) {
+                return false;
+            }
+
+            segment_header header{};
+            header.count      = count;
+            header.start_time = start_time;
+            header.end_time   = end_time;
+            header.name_size  = static_cast<std::uint16_t>(name.size());
+
+            detail::write_pod(m_out, header);
+            m_out.write(name.data(), static_cast<std::streamsize>(header.name_size));
+            m_out.flush();
+
+            const auto& size = static_cast<std::uint32_t>(sizeof(header) + header.name_size);
+            if (m_out) {
+                const segment_view view{start_time, end_time, count, name.substr(0, header.name_size)};
+                m_index.add(make_entry(view, m_offset, size), view.name);
+                m_offset += size;
+            }
+            return static_cast<bool>(m_out);
+        }
+
+        inline std::size_t pending() const noexcept { return m_time_delta.size(); }
+
+        /* Bytes on disk, buffered records not included */
+        inline std::uint64_t size() const noexcept { return m_offset; }
+
+        inline void close() {
+            m_out.close();
+            m_index.close();
+        }
+
+     private:
+        std::ofstream m_out{};
+        index_writer m_index{};
+        /* Size of the log, where the next chunk starts */
+        std::uint64_t m_offset{};
+
+        /* Milliseconds, the block's base_time */
+        std::int64_t m_base_time{};
+        /* Nanoseconds */
+        std::int64_t m_last_time{};
+        std::vector<std::uint32_t> m_time_delta{};
+        std::vector<std::uint32_t> m_fraction{};
+        std::vector<std::uint8_t> m_key{};
+        std::vector<std::uint8_t> m_type{};
+    };
+
+    /**
+     * Sequential block reader.
+     */
+    class reader final {
+     public:
+        struct block {
+            std::int64_t base_time{};
+            std::string name{};
+            std::vector<std::uint32_t> time_delta{};
+            /* Empty before version 3 */
+            std::vector<std::uint32_t> fraction{};
+            std::vector<std::uint8_t> key{};
+            std::vector<std::uint8_t> type{};
+
+            inline std::size_t size() const noexcept { return time_delta.size(); }
+
+            /* Expands the columns back into absolute-time records */
+            std::vector<record> records() const {
+                std::vector<record> result(size());
+                std::int64_t time = base_time;
+                for (std::size_t i = 0; i < size(); ++i) {
+                    time += time_delta[i];
+                    const std::int64_t& sub_ms = fraction.empty() ? 0 : fraction[i];
+                    result[i] = {time * detail::ns_per_ms + sub_ms, key[i], type[i]};
+                }
+                return result;
+            }
+        };
+
+        explicit reader(const std::filesystem::path& path) : m_in(path, std::ios::binary) {
+            file_header header{};
+            m_valid   = detail::read_pod(m_in, header) && detail::readable_header(header);
+            m_version = header.version;
+        }
+
+        inline bool valid() const noexcept { return m_valid; }
+
+        /**
+         * Reads the next complete block, skipping segments.
+         * @return false at the end of the file or on a truncated block.
+         */
+        bool next(block& out) {
+            segment skipped{};
+            chunk_type type{};
+            while ((type = next(out, skipped)) == chunk_type::segment) { }
+            return type == chunk_type::block;
+        }
+
+        /**
+         * Reads the next complete chunk into either out_block or out_segment.
+         * @return chunk_type::none at the end of the file or on a truncated chunk.
+         */
+        chunk_type next(block& out_block, segment& out_segment) {
+            if (!m_valid) {
+                return chunk_type::none;
+            }
+
+            std::uint32_t magic{};
+            if (!detail::read_pod(m_in, magic)) {
+                return chunk_type::none;
+            }
+            m_in.seekg(-static_cast<std::streamoff>(sizeof(magic)), std::ios::cur);
+
+            if (magic == block_magic) {
+                return read_block(out_block) ? chunk_type::block : chunk_type::none;
+            }
+            if (magic == segment_magic) {
+                return read_segment(out_segment) ? chunk_type::segment : chunk_type::none;
+            }
+            return chunk_type::none;
+        }
+
+     private:
+        std::ifstream m_in;
+        std::uint16_t m_version{};
+        bool m_valid{};
+
+        bool read_block(block& out) {
+            block_header header{};
+            if (!detail::read_pod(m_in, header)) {
+                return false;
+            }
+
+            out.base_time = header.base_time;
+            out.name.resize(header.name_size);
+            if (!m_in.read(out.name.data(), static_cast<std::streamsize>(header.name_size))) {
+                return false;
+            }
+            out.fraction.clear();
+            return detail::read_column(m_in, out.time_delta, header.count)
+                && (m_version < 3 || detail::read_column(m_in, out.fraction, header.count))
+                && detail::read_column(m_in, out.key, header.count)
+                && detail::read_column(m_in, out.type, header.count);
+        }
+
+        bool read_segment(segment& out) {
+            segment_header header{};
+            if (!detail::read_pod(m_in, header)) {
+                return false;
+            }
+
+            out.start_time = header.start_time;
+            out.end_time   = header.end_time;
+            out.count      = header.count;
+            out.name.resize(header.name_size);
+            return static_cast<bool>(m_in.read(out.name.data(), static_cast<std::streamsize>(header.name_size)));
+        }
+    };
+}  // namespace session_log
+}  // namespace vnepogodin
+
+#endif  // SESSION_LOG_HPP
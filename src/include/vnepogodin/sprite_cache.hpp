@@ -0,0 +1,83 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef SPRITE_CACHE_HPP
+#define SPRITE_CACHE_HPP
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+
+class QPaintDevice;
+
+namespace vnepogodin {
+/**
+ * Rasterizes svg assets once and keeps them packed in a single atlas image.
+ * All sprites share one scale; asking for another scale drops the atlas.
+ */
+class SpriteCache final {
+ public:
+    SpriteCache() = default;
+
+    /**
+     * @param prefix is the resource directory of the asset, used only to
+     * rasterize it on first use.
+     * @return location of the asset inside atlas().
+     */
+    QRect find(const std::string_view& prefix, const std::string_view& name, const double& scale);
+
+    /**
+     * Blits the asset from the atlas onto the device.
+     */
+    void draw(QPaintDevice* device, const QPoint& place, const std::string_view& prefix, const std::string_view& name, const double& scale);
+
+    /**
+     * Drops every sprite, must be called when the output size changes.
+     */
+    void invalidate() noexcept;
+
+    inline const QImage& atlas() const noexcept { return m_atlas; }
+
+ private:
+    struct string_hash {
+        using is_transparent = void;
+        inline std::size_t operator()(const std::string_view& str) const noexcept {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    static constexpr int atlas_width = 1024;
+
+    double m_scale{};
+
+    QImage m_atlas;
+    QPoint m_cursor{};
+    int m_shelf_height{};
+
+    std::unordered_map<std::string, QRect, string_hash, std::equal_to<>> m_sprites;
+
+    QRect allocate(const QSize& size);
+};
+}  // namespace vnepogodin
+
+#endif  // SPRITE_CACHE_HPP
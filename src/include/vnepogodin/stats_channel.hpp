@@ -0,0 +1,135 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef STATS_CHANNEL_HPP
+#define STATS_CHANNEL_HPP
+
+#include <vnepogodin/apm_counter.hpp>
+#include <vnepogodin/motion_sampler.hpp>
+#include <vnepogodin/seqlock.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include <QSharedMemory>
+#include <QString>
+
+/**
+ * Live stats shared by the overlay with GOATTech-settings and the webui.
+ *
+ * The overlay is the only writer. Readers attach once and from then on
+ * read through the seqlock, without locking the segment or making syscalls.
+ */
+namespace vnepogodin {
+namespace stats_channel {
+    static constexpr std::string_view key  = "GOATTech-stats";
+    static constexpr std::uint32_t magic   = 0x54535447;  // "GTST"
+    static constexpr std::uint32_t version = 2;
+
+    struct payload {
+        apm_snapshot apm{};
+        /* Mouse motion closed since the previous publish, zero while the mouse rests */
+        motion_sample motion{};
+        /* Unix time in milliseconds */
+        std::int64_t published_at{};
+    };
+    static_assert(std::is_trivially_copyable<payload>::value, "payload must stay memcpy-able");
+
+    struct segment {
+        /* Set last, once the rest of the segment is initialized */
+        std::atomic<std::uint32_t> magic{};
+        std::uint32_t version{stats_channel::version};
+        /* Catches layout mismatches between builds */
+        std::uint32_t size{sizeof(segment)};
+        std::uint32_t reserved{};
+        seqlock<payload> data{};
+    };
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+        "lock-based atomics don't work across processes");
+
+    inline QString name() { return QString::fromUtf8(key.data(), static_cast<int>(key.size())); }
+}  // namespace stats_channel
+
+/**
+ * Read side of the stats channel.
+ */
+class StatsReader final {
+ public:
+    StatsReader() : m_memory(stats_channel::name()) { }
+
+    /**
+     * Attaches to the overlay's segment, cheap to call again when attached.
+     * @return false if the overlay isn't running or is an incompatible build.
+     */
+    bool attach() {
+        if (m_segment != nullptr) {
+            return true;
+        }
+        if (!m_memory.isAttached() && !m_memory.attach(QSharedMemory::ReadOnly)) {
+            return false;
+        }
+
+        const auto* segment = static_cast<const stats_channel::segment*>(m_memory.constData());
+        if (static_cast<std::size_t>(m_memory.size()) < sizeof(stats_channel::segment)
+            || segment->magic.load(std::memory_order_acquire) != stats_channel::magic
+            || segment->version != stats_channel::version || segment->size != sizeof(stats_channel::segment)) {
+            m_memory.detach();
+            return false;
+        }
+
+        m_segment = segment;
+        return true;
+    }
+
+    /**
+     * @return false if not attached, the overlay quit or it died mid-update.
+     */
+    inline bool read(stats_channel::payload& out) {
+        return alive() && m_segment->data.try_load(out);
+    }
+
+    /* Changes whenever the overlay publishes */
+    inline std::uint64_t version() {
+        return alive() ? m_segment->data.version() : 0;
+    }
+
+ private:
+    QSharedMemory m_memory;
+    const stats_channel::segment* m_segment{};
+
+    /**
+     * The overlay clears magic when it quits. Detaches then, so the next
+     * attach() finds whichever overlay runs next.
+     */
+    bool alive() {
+        if (m_segment == nullptr) {
+            return false;
+        }
+        if (m_segment->magic.load(std::memory_order_acquire) != stats_channel::magic) {
+            m_segment = nullptr;
+            m_memory.detach();
+            return false;
+        }
+        return true;
+    }
+};
+}  // namespace vnepogodin
+
+#endif  // STATS_CHANNEL_HPP
@@ -0,0 +1,62 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef STATS_PUBLISHER_HPP
+#define STATS_PUBLISHER_HPP
+
+#include <vnepogodin/stats_channel.hpp>
+
+#include <QObject>
+#include <QSharedMemory>
+#include <QTimer>
+
+namespace vnepogodin {
+/**
+ * Copies the overlay's counters into the stats channel a few times a
+ * second. The timer stops once the counters settle and wake() restarts it.
+ */
+class StatsPublisher final : public QObject {
+    Q_OBJECT
+    Q_DISABLE_COPY(StatsPublisher)
+ public:
+    static constexpr int publish_interval_ms = 250;
+
+    explicit StatsPublisher(QObject* parent = nullptr);
+    virtual ~StatsPublisher();
+
+    inline bool isAttached() const noexcept { return m_segment != nullptr; }
+
+ public slots:
+    /**
+     * Resumes publishing, connected to input changes.
+     */
+    void wake();
+
+ private:
+    QSharedMemory m_memory;
+    stats_channel::segment* m_segment{};
+    QTimer m_timer;
+    apm_snapshot m_last{};
+    std::uint64_t m_motion_version{};
+    bool m_moving{};
+
+    void publish();
+};
+}  // namespace vnepogodin
+
+#endif  // STATS_PUBLISHER_HPP
@@ -19,18 +19,50 @@
 #ifndef UIOHOOK_HELPER_HPP
 #define UIOHOOK_HELPER_HPP
 
-#include <vnepogodin/buffer.hpp>
+#include <vnepogodin/broadcast_ring.hpp>
+#include <vnepogodin/event_clock.hpp>
+#include <vnepogodin/session_log.hpp>
 
 #include <atomic>
-#include <mutex>
+#include <cstdint>
 
 #include <uiohook.h>
 
 namespace uiohook {
 
+/* Capacity of the hook -> overlays event bus */
+static constexpr std::size_t event_queue_size = 4096;
+using event_queue                             = vnepogodin::broadcast_ring<vnepogodin::timed_event, event_queue_size>;
+
 extern std::atomic<bool> hook_state;
-extern std::mutex buffer_mutex;
-extern vnepogodin::buffer buf;
+extern event_queue buf;
+
+/* Called from the hook thread whenever a key or button changes state, or mouse motion starts being held back */
+using notify_proc_t = void (*)(void* user_data);
+
+/* Must be set before start() and cleared only after stop() */
+void set_notify_proc(notify_proc_t proc, void* user_data) noexcept;
+
+/* Key log rotation, must be set before start() */
+void set_log_policy(const vnepogodin::session_log::rotation_policy& policy) noexcept;
+
+/* Mouse motion is coalesced into one event per interval, must be set before start() */
+void set_motion_interval(const std::int64_t& interval_us) noexcept;
+
+/* Where events come from, evdev only exists on Linux */
+enum class backend : std::uint8_t {
+    native,
+    evdev
+};
+
+/**
+ * Must be set before start(). evdev falls back to the native hook when
+ * no input device is readable.
+ */
+void set_backend(const backend& source) noexcept;
+
+/* Desktop the evdev cursor moves in, must be set before start() */
+void set_desktop(const std::int16_t& x, const std::int16_t& y, const std::int16_t& width, const std::int16_t& height) noexcept;
 
 bool logger_proc(unsigned level, const char* format, ...);
 
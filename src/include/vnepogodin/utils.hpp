@@ -20,6 +20,7 @@
 #define UTILS_HPP
 
 #include <vnepogodin/input_data.hpp>
+#include <vnepogodin/key_layout.hpp>
 #include <vnepogodin/overlay_keyboard.hpp>
 #include <vnepogodin/overlay_mouse.hpp>
 #include <vnepogodin/uiohook_helper.hpp>
@@ -30,59 +31,12 @@
 
 #ifndef _WIN32
 #include <HTTPRequest.hpp>
-#include <frozen/unordered_map.h>
 #endif
 #include <nlohmann/json.hpp>
 
 namespace vnepogodin {
 namespace utils {
-    namespace key_code {
-        static constexpr std::uint8_t LBUTTON = MOUSE_BUTTON1;
-        /* clang-format off */
-#ifndef _WIN32
-        static constexpr std::uint8_t RBUTTON = MOUSE_BUTTON3;
-        static constexpr std::uint8_t MBUTTON = MOUSE_BUTTON2;
-#else
-        static constexpr std::uint8_t RBUTTON = MOUSE_BUTTON2;
-        static constexpr std::uint8_t MBUTTON = MOUSE_BUTTON3;
-#endif
-        /* clang-format on */
-        static constexpr std::uint8_t X1BUTTON = MOUSE_BUTTON4;
-        static constexpr std::uint8_t X2BUTTON = MOUSE_BUTTON5;
-
-        static constexpr std::uint32_t W         = VC_W;
-        static constexpr std::uint32_t A         = VC_A;
-        static constexpr std::uint32_t S         = VC_S;
-        static constexpr std::uint32_t D         = VC_D;
-        static constexpr std::uint32_t Q         = VC_Q;
-        static constexpr std::uint32_t E         = VC_E;
-        static constexpr std::uint32_t SHIFT     = VC_SHIFT_L;
-        static constexpr std::uint32_t CONTROL   = VC_CONTROL_L;
-        static constexpr std::uint32_t SPACEBAR  = VC_SPACE;
-        static constexpr std::uint32_t UNDEFINED = VC_UNDEFINED;
-    }  // namespace key_code
-
     namespace {
-#ifndef _WIN32
-        static constexpr frozen::unordered_map<std::uint32_t, std::string_view, 14> code_list = {
-#else
-        static std::unordered_map<std::uint32_t, std::string_view> code_list = {
-#endif
-            {vnepogodin::utils::key_code::W, "w_button"},
-            {vnepogodin::utils::key_code::A, "a_button"},
-            {vnepogodin::utils::key_code::S, "s_button"},
-            {vnepogodin::utils::key_code::D, "d_button"},
-            {vnepogodin::utils::key_code::Q, "q_button"},
-            {vnepogodin::utils::key_code::E, "e_button"},
-            {vnepogodin::utils::key_code::SHIFT, "shift_button"},
-            {vnepogodin::utils::key_code::CONTROL, "ctrl_button"},
-            {vnepogodin::utils::key_code::SPACEBAR, "space_button"},
-            {vnepogodin::utils::key_code::LBUTTON, "left_button"},
-            {vnepogodin::utils::key_code::RBUTTON, "right_button"},
-            {vnepogodin::utils::key_code::MBUTTON, "middle_button"},
-            {vnepogodin::utils::key_code::X1BUTTON, "x_button"},
-            {vnepogodin::utils::key_code::X2BUTTON, "x_button"}};
-
         static inline int parse_int(const std::string_view& str) {
             int result = 0;
             std::from_chars(str.data(), str.data() + str.size(), result);
@@ -112,14 +66,26 @@ namespace utils {
         }
     }
 
-    constexpr bool handle_event(input_data* handler) noexcept {
-        uiohook_event* event = uiohook::buf.read<uiohook_event>();
-        if (event) {
-            handler->dispatch_uiohook_event(event);
-            return true;
-        }
+    /**
+     * Feeds every event the subscriber hasn't seen yet into the handler.
+     * @return number of dispatched events.
+     */
+    inline std::size_t handle_event(input_data* handler, uiohook::event_queue::cursor& cursor) noexcept {
+        return uiohook::buf.drain(cursor, [handler](const timed_event& captured) {
+            handler->dispatch_uiohook_event(&captured.event);
+        });
+    }
 
-        return false;
+    /**
+     * Same as above, also handing every event to on_event.
+     * @return number of dispatched events.
+     */
+    template <class Fn>
+    inline std::size_t handle_event(input_data* handler, uiohook::event_queue::cursor& cursor, Fn&& on_event) noexcept {
+        return uiohook::buf.drain(cursor, [handler, &on_event](const timed_event& captured) {
+            handler->dispatch_uiohook_event(&captured.event);
+            on_event(captured);
+        });
     }
 
     inline void send_json() noexcept {
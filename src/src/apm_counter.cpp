@@ -0,0 +1,92 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/apm_counter.hpp>
+#include <vnepogodin/event_clock.hpp>
+
+using namespace vnepogodin;
+
+namespace local_data {
+ApmCounter apm;
+}  // namespace local_data
+
+float apm_snapshot::per_minute(const apm_window& window, const std::size_t& row) const noexcept {
+    static constexpr float seconds_per_minute = 60.F;
+    static constexpr std::array<float, window_count> window_seconds = {1.F, 10.F, 60.F};
+
+    const auto& idx = static_cast<std::size_t>(window);
+    return static_cast<float>(counts[idx][row]) * seconds_per_minute / window_seconds[idx];
+}
+
+std::int64_t ApmCounter::now() noexcept {
+    return event_clock::now() / event_clock::ns_per_ms;
+}
+
+void ApmCounter::add(const layout::key_index_t& key) noexcept {
+    add(key, now());
+}
+
+void ApmCounter::add(const layout::key_index_t& key, const std::int64_t& time_ms) noexcept {
+    const auto& tick = time_ms / tick_ms;
+    auto& row        = m_counts[static_cast<std::size_t>(tick) % bucket_count];
+
+    if (tick != m_last_tick) {
+        // First press in this bucket's new period, drop what's left from a lap ago.
+        for (auto& count : row) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        m_bucket_tick[static_cast<std::size_t>(tick) % bucket_count].store(tick, std::memory_order_release);
+        m_last_tick = tick;
+    }
+
+    if (key != layout::npos) {
+        row[key].fetch_add(1, std::memory_order_relaxed);
+        m_totals[key].fetch_add(1, std::memory_order_relaxed);
+    }
+    row[apm_snapshot::total_row].fetch_add(1, std::memory_order_relaxed);
+    m_totals[apm_snapshot::total_row].fetch_add(1, std::memory_order_relaxed);
+}
+
+apm_snapshot ApmCounter::snapshot() const noexcept {
+    return snapshot(now());
+}
+
+apm_snapshot ApmCounter::snapshot(const std::int64_t& time_ms) const noexcept {
+    const auto& tick = time_ms / tick_ms;
+
+    apm_snapshot result{};
+    for (std::size_t row = 0; row < apm_snapshot::row_count; ++row) {
+        result.totals[row] = m_totals[row].load(std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        const auto& age = tick - m_bucket_tick[i].load(std::memory_order_acquire);
+        if (age < 0 || age >= window_ticks.back()) {
+            continue;
+        }
+
+        for (std::size_t row = 0; row < apm_snapshot::row_count; ++row) {
+            const auto& count = m_counts[i][row].load(std::memory_order_relaxed);
+            for (std::size_t window = 0; window < apm_snapshot::window_count; ++window) {
+                if (age < window_ticks[window]) {
+                    result.counts[window][row] += count;
+                }
+            }
+        }
+    }
+    return result;
+}
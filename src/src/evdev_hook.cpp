@@ -0,0 +1,499 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/evdev_hook.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <ctime>
+
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace vnepogodin;
+
+namespace {
+/* Same default as most desktops, the X11 setting isn't reachable from here */
+static constexpr std::uint64_t multi_click_time_ms = 500;
+/* Touchpad travel to cursor travel, there is no acceleration to make up for it */
+static constexpr std::int64_t touchpad_px_per_mm = 20;
+static constexpr std::size_t bits_per_long       = sizeof(unsigned long) * 8;
+
+/* KEY_* -> VC_*, codes below 89 are the PC scancodes VC_* already uses */
+constexpr std::uint16_t to_virtual_code(const std::uint16_t& code) noexcept {
+    // clang-format off
+    switch (code) {
+    case KEY_102ND:      return VC_LESSER_GREATER;
+    case KEY_KPENTER:    return VC_KP_ENTER;
+    case KEY_RIGHTCTRL:  return VC_CONTROL_R;
+    case KEY_KPSLASH:    return VC_KP_DIVIDE;
+    case KEY_SYSRQ:      return VC_PRINTSCREEN;
+    case KEY_RIGHTALT:   return VC_ALT_R;
+    case KEY_HOME:       return VC_HOME;
+    case KEY_UP:         return VC_UP;
+    case KEY_PAGEUP:     return VC_PAGE_UP;
+    case KEY_LEFT:       return VC_LEFT;
+    case KEY_RIGHT:      return VC_RIGHT;
+    case KEY_END:        return VC_END;
+    case KEY_DOWN:       return VC_DOWN;
+    case KEY_PAGEDOWN:   return VC_PAGE_DOWN;
+    case KEY_INSERT:     return VC_INSERT;
+    case KEY_DELETE:     return VC_DELETE;
+    case KEY_MUTE:       return VC_VOLUME_MUTE;
+    case KEY_VOLUMEDOWN: return VC_VOLUME_DOWN;
+    case KEY_VOLUMEUP:   return VC_VOLUME_UP;
+    case KEY_KPEQUAL:    return VC_KP_EQUALS;
+    case KEY_PAUSE:      return VC_PAUSE;
+    case KEY_LEFTMETA:   return VC_META_L;
+    case KEY_RIGHTMETA:  return VC_META_R;
+    case KEY_COMPOSE:    return VC_CONTEXT_MENU;
+    case KEY_F13:        return VC_F13;
+    case KEY_F14:        return VC_F14;
+    case KEY_F15:        return VC_F15;
+    case KEY_F16:        return VC_F16;
+    case KEY_F17:        return VC_F17;
+    case KEY_F18:        return VC_F18;
+    case KEY_F19:        return VC_F19;
+    case KEY_F20:        return VC_F20;
+    case KEY_F21:        return VC_F21;
+    case KEY_F22:        return VC_F22;
+    case KEY_F23:        return VC_F23;
+    case KEY_F24:        return VC_F24;
+    default:             return (code < KEY_ZENKAKUHANKAKU) ? code : VC_UNDEFINED;
+    }
+    // clang-format on
+}
+
+/* BTN_* -> MOUSE_BUTTON*, numbered the way libuiohook does on X11 */
+constexpr std::uint16_t to_mouse_button(const std::uint16_t& code) noexcept {
+    switch (code) {
+    case BTN_LEFT:
+        return MOUSE_BUTTON1;
+    case BTN_MIDDLE:
+        return MOUSE_BUTTON2;
+    case BTN_RIGHT:
+        return MOUSE_BUTTON3;
+    case BTN_SIDE:
+        return MOUSE_BUTTON4;
+    case BTN_EXTRA:
+        return MOUSE_BUTTON5;
+    default:
+        return MOUSE_NOBUTTON;
+    }
+}
+
+constexpr std::uint16_t modifier_mask(const std::uint16_t& keycode) noexcept {
+    switch (keycode) {
+    case VC_SHIFT_L:
+        return MASK_SHIFT_L;
+    case VC_SHIFT_R:
+        return MASK_SHIFT_R;
+    case VC_CONTROL_L:
+        return MASK_CTRL_L;
+    case VC_CONTROL_R:
+        return MASK_CTRL_R;
+    case VC_ALT_L:
+        return MASK_ALT_L;
+    case VC_ALT_R:
+        return MASK_ALT_R;
+    case VC_META_L:
+        return MASK_META_L;
+    case VC_META_R:
+        return MASK_META_R;
+    default:
+        return 0;
+    }
+}
+
+constexpr std::uint16_t button_mask(const std::uint16_t& button) noexcept {
+    return (button >= MOUSE_BUTTON1 && button <= MOUSE_BUTTON5) ? static_cast<std::uint16_t>(MASK_BUTTON1 << (button - MOUSE_BUTTON1)) : 0;
+}
+
+static constexpr std::uint16_t any_button_mask = MASK_BUTTON1 | MASK_BUTTON2 | MASK_BUTTON3 | MASK_BUTTON4 | MASK_BUTTON5;
+
+inline bool test_bit(const unsigned long* bits, const std::size_t& bit) noexcept {
+    return (bits[bit / bits_per_long] >> (bit % bits_per_long)) & 1UL;
+}
+
+inline std::uint64_t monotonic_ms() noexcept {
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<std::uint64_t>(now.tv_sec) * 1000 + static_cast<std::uint64_t>(now.tv_nsec) / 1000000;
+}
+}  // namespace
+
+EvdevHook::~EvdevHook() {
+    close_devices();
+}
+
+int EvdevHook::run(dispatcher_t dispatch_proc) {
+    m_dispatch = dispatch_proc;
+    if (!open_devices()) {
+        close_devices();
+        return UIOHOOK_FAILURE;
+    }
+
+    m_x = static_cast<std::int16_t>(m_bounds.x + m_bounds.width / 2);
+    m_y = static_cast<std::int16_t>(m_bounds.y + m_bounds.height / 2);
+    dispatch(EVENT_HOOK_ENABLED, monotonic_ms());
+
+    static constexpr int max_events = 16;
+    std::array<epoll_event, max_events> events{};
+    for (bool running = true; running;) {
+        const int& count = ::epoll_wait(m_epoll_fd, events.data(), max_events, -1);
+        if (count < 0 && errno != EINTR) {
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (events[static_cast<std::size_t>(i)].data.fd == m_stop_fd.load(std::memory_order_relaxed)) {
+                running = false;
+                continue;
+            }
+            read_device(events[static_cast<std::size_t>(i)].data.fd);
+        }
+    }
+
+    dispatch(EVENT_HOOK_DISABLED, monotonic_ms());
+    close_devices();
+    return UIOHOOK_SUCCESS;
+}
+
+void EvdevHook::stop() noexcept {
+    if (const auto& fd = m_stop_fd.load(std::memory_order_acquire); fd >= 0) {
+        static constexpr std::uint64_t wake = 1;
+        [[maybe_unused]] const auto& written = ::write(fd, &wake, sizeof(wake));
+    }
+}
+
+bool EvdevHook::open_devices() {
+    const int& stop_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    m_stop_fd.store(stop_fd, std::memory_order_release);
+    m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd < 0 || stop_fd < 0) {
+        return false;
+    }
+
+    epoll_event stop_event{};
+    stop_event.events  = EPOLLIN;
+    stop_event.data.fd = stop_fd;
+    ::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, stop_fd, &stop_event);
+
+    // Scanned devices must look like a keyboard or a mouse, given ones are trusted.
+    const bool& scan = m_devices.empty();
+    std::vector<std::filesystem::path> paths = m_devices;
+    if (scan) {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/dev/input", ec)) {
+            if (entry.path().filename().string().starts_with("event")) {
+                paths.push_back(entry.path());
+            }
+        }
+    }
+
+    for (const auto& path : paths) {
+        const int& fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+
+        unsigned long types[1]{};
+        if (scan && (::ioctl(fd, EVIOCGBIT(0, sizeof(types)), types) < 0 || !(test_bit(types, EV_KEY) || test_bit(types, EV_REL)))) {
+            ::close(fd);
+            continue;
+        }
+
+        // Kernel timestamps on the same clock as the rest of the pipeline.
+        int clock = CLOCK_MONOTONIC;
+        ::ioctl(fd, EVIOCSCLOCKID, &clock);
+
+        epoll_event device_event{};
+        device_event.events  = EPOLLIN;
+        device_event.data.fd = fd;
+        if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &device_event) < 0) {
+            ::close(fd);
+            continue;
+        }
+        m_fds.push_back(fd);
+        add_abs_device(fd);
+    }
+    return !m_fds.empty();
+}
+
+void EvdevHook::add_abs_device(const int& fd) {
+    unsigned long types[1]{};
+    unsigned long axes[ABS_MAX / bits_per_long + 1]{};
+    unsigned long keys[KEY_MAX / bits_per_long + 1]{};
+    unsigned long props[INPUT_PROP_MAX / bits_per_long + 1]{};
+    if (::ioctl(fd, EVIOCGBIT(0, sizeof(types)), types) < 0 || !test_bit(types, EV_ABS)
+        || ::ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(axes)), axes) < 0 || !test_bit(axes, ABS_X) || !test_bit(axes, ABS_Y)
+        || ::ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0) {
+        return;
+    }
+
+    // Joysticks have ABS_X / ABS_Y too, pointers come with a touch or a tool.
+    const bool& pen    = test_bit(keys, BTN_TOOL_PEN);
+    const bool& finger = test_bit(keys, BTN_TOOL_FINGER);
+    if (!pen && !finger && !test_bit(keys, BTN_TOUCH)) {
+        return;
+    }
+
+    const auto& read_axis = [&fd](const unsigned int& code, abs_axis& axis) {
+        input_absinfo info{};
+        if (::ioctl(fd, EVIOCGABS(code), &info) < 0 || info.maximum <= info.minimum) {
+            return false;
+        }
+        axis = {info.minimum, info.maximum, info.resolution};
+        return true;
+    };
+
+    abs_device device{};
+    device.fd = fd;
+    if (!read_axis(ABS_X, device.x) || !read_axis(ABS_Y, device.y)) {
+        return;
+    }
+    ::ioctl(fd, EVIOCGPROP(sizeof(props)), props);
+    device.touchpad = finger && !pen && test_bit(props, INPUT_PROP_POINTER);
+    m_abs_devices.push_back(device);
+}
+
+void EvdevHook::close_devices() noexcept {
+    for (const auto& fd : m_fds) {
+        ::close(fd);
+    }
+    m_fds.clear();
+    m_abs_devices.clear();
+
+    if (m_epoll_fd >= 0) {
+        ::close(m_epoll_fd);
+        m_epoll_fd = -1;
+    }
+    if (const auto& fd = m_stop_fd.exchange(-1, std::memory_order_acq_rel); fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void EvdevHook::read_device(const int& fd) {
+    static constexpr std::size_t batch_size = 64;
+    std::array<input_event, batch_size> batch{};
+
+    const auto& abs_it = std::find_if(m_abs_devices.begin(), m_abs_devices.end(), [&fd](const auto& device) { return device.fd == fd; });
+    auto* abs          = (abs_it != m_abs_devices.end()) ? &*abs_it : nullptr;
+
+    for (;;) {
+        const auto& size = ::read(fd, batch.data(), sizeof(batch));
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            // Unplugged, the rest of the devices keep going.
+            if (size == 0 || errno == ENODEV) {
+                ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+                ::close(fd);
+                m_fds.erase(std::remove(m_fds.begin(), m_fds.end(), fd), m_fds.end());
+                if (abs != nullptr) {
+                    m_abs_devices.erase(abs_it);
+                }
+            }
+            return;
+        }
+
+        const auto& count = static_cast<std::size_t>(size) / sizeof(input_event);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& ev   = batch[i];
+            const auto& time = static_cast<std::uint64_t>(ev.input_event_sec) * 1000 + static_cast<std::uint64_t>(ev.input_event_usec) / 1000;
+            switch (ev.type) {
+            case EV_KEY:
+                if (ev.code == BTN_TOUCH && abs != nullptr) {
+                    // Lifting the finger ends a touchpad stroke, on tablets and touchscreens a touch is a left click.
+                    if (!abs->touchpad) {
+                        abs->touch = ev.value;
+                    } else if (ev.value == 0) {
+                        abs->x.tracking = false;
+                        abs->y.tracking = false;
+                    }
+                    break;
+                }
+                on_key(ev.code, ev.value, time);
+                break;
+            case EV_ABS:
+                if (abs != nullptr && (ev.code == ABS_X || ev.code == ABS_Y)) {
+                    on_abs(*abs, ev.code, ev.value);
+                }
+                break;
+            case EV_REL:
+                if (ev.code == REL_X || ev.code == REL_Y) {
+                    auto& axis        = (ev.code == REL_X) ? m_x : m_y;
+                    const auto& first = (ev.code == REL_X) ? m_bounds.x : m_bounds.y;
+                    const auto& last  = first + std::max<std::int32_t>((ev.code == REL_X) ? m_bounds.width : m_bounds.height, 1) - 1;
+                    axis              = static_cast<std::int16_t>(std::clamp<std::int32_t>(axis + ev.value, first, last));
+                    m_moved           = true;
+                } else if (ev.code == REL_WHEEL || ev.code == REL_HWHEEL) {
+                    on_wheel(ev.value, (ev.code == REL_WHEEL) ? WHEEL_VERTICAL_DIRECTION : WHEEL_HORIZONTAL_DIRECTION, time);
+                }
+                break;
+            case EV_SYN:
+                if (ev.code == SYN_REPORT) {
+                    on_frame(time);
+                    // After the motion, the touch landed where the frame ended.
+                    if (abs != nullptr && abs->touch >= 0) {
+                        on_button(MOUSE_BUTTON1, abs->touch, time);
+                        abs->touch = -1;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void EvdevHook::dispatch(const event_type& type, const std::uint64_t& time) {
+    m_event.type     = type;
+    m_event.time     = time;
+    m_event.mask     = m_mask;
+    m_event.reserved = 0x00;
+    if (m_dispatch != nullptr) {
+        m_dispatch(&m_event);
+    }
+}
+
+void EvdevHook::on_key(const std::uint16_t& code, const std::int32_t& value, const std::uint64_t& time) {
+    // Auto-repeat is left out, only physical presses count.
+    if (value != 0 && value != 1) {
+        return;
+    }
+
+    if (const auto& button = to_mouse_button(code); button != MOUSE_NOBUTTON) {
+        on_button(button, value, time);
+        return;
+    }
+
+    const auto& keycode = to_virtual_code(code);
+    if (keycode == VC_UNDEFINED) {
+        return;
+    }
+
+    const auto& mask = modifier_mask(keycode);
+    m_mask           = static_cast<std::uint16_t>(value ? (m_mask | mask) : (m_mask & ~mask));
+
+    m_event.data.keyboard.keycode = keycode;
+    m_event.data.keyboard.rawcode = code;
+    m_event.data.keyboard.keychar = CHAR_UNDEFINED;
+    dispatch(value ? EVENT_KEY_PRESSED : EVENT_KEY_RELEASED, time);
+}
+
+void EvdevHook::on_button(const std::uint16_t& button, const std::int32_t& value, const std::uint64_t& time) {
+    // Pending motion comes first, the button happened where it ended.
+    on_frame(time);
+
+    if (value) {
+        if (button == m_click_button && time - m_click_time <= multi_click_time_ms) {
+            m_click_count = static_cast<std::uint16_t>(std::min<std::uint32_t>(m_click_count + 1U, UINT16_MAX));
+        } else {
+            m_click_count  = 1;
+            m_click_button = button;
+        }
+        m_click_time = time;
+        m_dragged    = false;
+        m_mask       = static_cast<std::uint16_t>(m_mask | button_mask(button));
+    } else {
+        m_mask = static_cast<std::uint16_t>(m_mask & ~button_mask(button));
+    }
+
+    m_event.data.mouse.button = button;
+    m_event.data.mouse.clicks = m_click_count;
+    m_event.data.mouse.x      = m_x;
+    m_event.data.mouse.y      = m_y;
+    dispatch(value ? EVENT_MOUSE_PRESSED : EVENT_MOUSE_RELEASED, time);
+
+    if (!value && !m_dragged && m_event.reserved == 0x00) {
+        m_event.data.mouse.button = button;
+        m_event.data.mouse.clicks = m_click_count;
+        m_event.data.mouse.x      = m_x;
+        m_event.data.mouse.y      = m_y;
+        dispatch(EVENT_MOUSE_CLICKED, time);
+    }
+}
+
+void EvdevHook::on_wheel(const std::int32_t& value, const std::uint8_t& direction, const std::uint64_t& time) {
+    static constexpr std::uint16_t units_per_notch = 3;
+
+    m_event.data.wheel.clicks    = 1;
+    m_event.data.wheel.x         = m_x;
+    m_event.data.wheel.y         = m_y;
+    m_event.data.wheel.type      = WHEEL_UNIT_SCROLL;
+    m_event.data.wheel.amount    = units_per_notch;
+    // Up and left are negative, like libuiohook reports them on X11.
+    const bool& is_away          = (direction == WHEEL_VERTICAL_DIRECTION) ? (value > 0) : (value < 0);
+    m_event.data.wheel.rotation  = static_cast<std::int16_t>(is_away ? -1 : 1);
+    m_event.data.wheel.direction = direction;
+    dispatch(EVENT_MOUSE_WHEEL, time);
+}
+
+void EvdevHook::on_abs(abs_device& device, const std::uint16_t& code, const std::int32_t& value) noexcept {
+    auto& axis              = (code == ABS_X) ? device.x : device.y;
+    auto& position          = (code == ABS_X) ? m_x : m_y;
+    const auto& first       = (code == ABS_X) ? m_bounds.x : m_bounds.y;
+    const std::int32_t size = std::max<std::int32_t>((code == ABS_X) ? m_bounds.width : m_bounds.height, 1);
+
+    std::int64_t target = position;
+    if (device.touchpad) {
+        // A new stroke picks up wherever the cursor is.
+        if (axis.tracking) {
+            const std::int64_t& pixels = (axis.resolution > 0) ? touchpad_px_per_mm : 1;
+            const std::int64_t units   = std::max(axis.resolution, 1);
+            const auto& moved          = static_cast<std::int64_t>(value - axis.last) * pixels + axis.remainder;
+            axis.remainder             = static_cast<std::int32_t>(moved % units);
+            target += moved / units;
+        }
+        axis.last     = value;
+        axis.tracking = true;
+    } else {
+        const auto& offset = static_cast<std::int64_t>(std::clamp(value, axis.minimum, axis.maximum)) - axis.minimum;
+        target             = first + offset * (size - 1) / (static_cast<std::int64_t>(axis.maximum) - axis.minimum);
+    }
+
+    const auto& clamped = static_cast<std::int16_t>(std::clamp<std::int64_t>(target, first, first + size - 1));
+    if (clamped != position) {
+        position = clamped;
+        m_moved  = true;
+    }
+}
+
+void EvdevHook::on_frame(const std::uint64_t& time) {
+    if (!m_moved) {
+        return;
+    }
+    m_moved = false;
+
+    const bool& is_dragged = (m_mask & any_button_mask) != 0;
+    m_dragged |= is_dragged;
+
+    m_event.data.mouse.button = MOUSE_NOBUTTON;
+    m_event.data.mouse.clicks = m_click_count;
+    m_event.data.mouse.x      = m_x;
+    m_event.data.mouse.y      = m_y;
+    dispatch(is_dragged ? EVENT_MOUSE_DRAGGED : EVENT_MOUSE_MOVED, time);
+}
@@ -0,0 +1,82 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/frame_scheduler.hpp>
+#include <vnepogodin/input_data.hpp>
+
+#include <QGuiApplication>
+#include <QScreen>
+
+using namespace vnepogodin;
+
+FrameScheduler::FrameScheduler(QObject* parent) : QObject(parent) {
+    static constexpr double fallback_refresh_rate = 60.0;
+
+    double refresh_rate = fallback_refresh_rate;
+    if (const auto* screen = QGuiApplication::primaryScreen(); screen && screen->refreshRate() > 0) {
+        refresh_rate = screen->refreshRate();
+    }
+    m_interval_ns = static_cast<qint64>(1e9 / refresh_rate);
+
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&m_timer, &QTimer::timeout, this, &FrameScheduler::emitFrame);
+
+    m_clock.start();
+    m_last_frame_ns = -m_interval_ns;
+}
+
+void FrameScheduler::requestFrame() noexcept {
+    // Only the first request after a frame crosses threads, the rest coalesce.
+    if (!m_pending.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, &FrameScheduler::schedule, Qt::QueuedConnection);
+    }
+}
+
+void FrameScheduler::notify_proc(void* user_data) noexcept {
+    static_cast<FrameScheduler*>(user_data)->requestFrame();
+}
+
+void FrameScheduler::schedule() {
+    if (m_timer.isActive()) {
+        return;
+    }
+
+    const auto& elapsed = m_clock.nsecsElapsed() - m_last_frame_ns;
+    if (elapsed >= m_interval_ns) {
+        emitFrame();
+        return;
+    }
+
+    // Too early for the display, wait for the next refresh slot.
+    static constexpr qint64 ns_per_ms = 1000000;
+    m_timer.start(static_cast<int>((m_interval_ns - elapsed + ns_per_ms - 1) / ns_per_ms));
+}
+
+void FrameScheduler::emitFrame() {
+    m_pending.store(false, std::memory_order_release);
+
+    const auto& generation = local_data::data.generation();
+    if (generation == m_generation) {
+        return;
+    }
+
+    m_generation    = generation;
+    m_last_frame_ns = m_clock.nsecsElapsed();
+    emit frame();
+}
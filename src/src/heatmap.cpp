@@ -0,0 +1,102 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/heatmap.hpp>
+
+#include <algorithm>
+
+using namespace vnepogodin;
+
+namespace local_data {
+Heatmap heatmap;
+}  // namespace local_data
+
+void Heatmap::set_geometry(const heatmap_file::geometry& desktop) noexcept {
+    if (desktop == m_desktop) {
+        return;
+    }
+
+    m_desktop = desktop;
+    for (auto& cell : m_cells) {
+        cell.store(0, std::memory_order_relaxed);
+    }
+    m_cell = heatmap_file::cell_count;
+}
+
+bool Heatmap::load(const std::filesystem::path& path) {
+    heatmap_file::file_header header{};
+    heatmap_file::grid cells;
+    if (!heatmap_file::read(path, header, cells) || header.desktop != m_desktop) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < heatmap_file::cell_count; ++i) {
+        m_cells[i].fetch_add(cells[i], std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool Heatmap::save(const std::filesystem::path& path) {
+    const auto& version = m_version.load(std::memory_order_relaxed);
+    if (version == m_saved_version) {
+        return true;
+    }
+
+    heatmap_file::grid cells(heatmap_file::cell_count);
+    for (std::size_t i = 0; i < heatmap_file::cell_count; ++i) {
+        cells[i] = m_cells[i].load(std::memory_order_relaxed);
+    }
+    if (!heatmap_file::write(path, m_desktop, cells)) {
+        return false;
+    }
+    m_saved_version = version;
+    return true;
+}
+
+void Heatmap::add(const std::int16_t& x, const std::int16_t& y, const std::int64_t& time_ns) noexcept {
+    static constexpr auto ns_per_ms = static_cast<std::uint32_t>(event_clock::ns_per_ms);
+
+    if (m_cell < heatmap_file::cell_count) {
+        // Sub-millisecond leftovers carry over to whichever cell is next.
+        m_dwell_ns += static_cast<std::uint32_t>(std::clamp<std::int64_t>(time_ns - m_last_time, 0, max_dwell_ns));
+        if (m_dwell_ns >= ns_per_ms) {
+            m_cells[m_cell].fetch_add(m_dwell_ns / ns_per_ms, std::memory_order_relaxed);
+            m_dwell_ns %= ns_per_ms;
+            m_version.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    m_cell      = cell(x, y);
+    m_last_time = time_ns;
+}
+
+std::size_t Heatmap::cell(const std::int16_t& x, const std::int16_t& y) const noexcept {
+    if (m_desktop.width <= 0 || m_desktop.height <= 0) {
+        return heatmap_file::cell_count;
+    }
+
+    const auto& dx = static_cast<std::int64_t>(x) - m_desktop.x;
+    const auto& dy = static_cast<std::int64_t>(y) - m_desktop.y;
+    if (dx < 0 || dy < 0 || dx >= m_desktop.width || dy >= m_desktop.height) {
+        return heatmap_file::cell_count;
+    }
+
+    const auto& col = static_cast<std::size_t>(dx * heatmap_file::cols / m_desktop.width);
+    const auto& row = static_cast<std::size_t>(dy * heatmap_file::rows / m_desktop.height);
+    return row * heatmap_file::cols + col;
+}
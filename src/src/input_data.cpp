@@ -19,35 +19,33 @@
 #include <vnepogodin/input_data.hpp>
 
 namespace local_data {
-std::mutex data_mutex;
-input_data data;
+input_data data{true};
 }  // namespace local_data
 
 void input_data::copy(const input_data* other) {
-    keyboard            = other->keyboard;
-    mouse               = other->mouse;
-    last_key_pressed    = other->last_key_pressed;
-    last_key_released   = other->last_key_released;
-    last_key_typed      = other->last_key_typed;
-    last_mouse_pressed  = other->last_mouse_pressed;
-    last_mouse_dragged  = other->last_mouse_dragged;
-    last_mouse_movement = other->last_mouse_movement;
-    last_wheel_event    = other->last_wheel_event;
-    last_mouse_released = other->last_mouse_released;
+    static_cast<input_snapshot&>(*this) = other->snapshot();
+    publish();
+}
+
+void input_data::publish() noexcept {
+    if (m_shared) {
+        m_published.store(*this);
+    } else {
+        ++m_generation;
+    }
 }
 
 void input_data::dispatch_uiohook_event(const uiohook_event* event) {
-    std::lock_guard<std::mutex> lock(m_mutex);
     last_event = *event;
 
     switch (event->type) {
     case EVENT_KEY_PRESSED:
-        last_key_pressed                       = event->data.keyboard;
-        keyboard[event->data.keyboard.keycode] = true;
+        last_key_pressed = event->data.keyboard;
+        keyboard.set(vnepogodin::keycode_index(event->data.keyboard.keycode), true);
         break;
     case EVENT_KEY_RELEASED:
-        last_key_released                      = event->data.keyboard;
-        keyboard[event->data.keyboard.keycode] = false;
+        last_key_released = event->data.keyboard;
+        keyboard.set(vnepogodin::keycode_index(event->data.keyboard.keycode), false);
         break;
     case EVENT_KEY_TYPED:
         last_key_typed = event->data.keyboard;
@@ -56,12 +54,12 @@ void input_data::dispatch_uiohook_event(const uiohook_event* event) {
         last_wheel_event = event->data.wheel;
         break;
     case EVENT_MOUSE_PRESSED:
-        last_mouse_pressed              = event->data.mouse;
-        mouse[event->data.mouse.button] = true;
+        last_mouse_pressed = event->data.mouse;
+        mouse.set(event->data.mouse.button, true);
         break;
     case EVENT_MOUSE_RELEASED:
-        last_mouse_released             = event->data.mouse;
-        mouse[event->data.mouse.button] = false;
+        last_mouse_released = event->data.mouse;
+        mouse.set(event->data.mouse.button, false);
         break;
     case EVENT_MOUSE_CLICKED:
         last_mouse_clicked = event->data.mouse;
@@ -74,4 +72,6 @@ void input_data::dispatch_uiohook_event(const uiohook_event* event) {
         break;
     default:;
     }
+
+    publish();
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include <vnepogodin/latency_tracer.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+using namespace vnepogodin;
+
+namespace local_data {
+LatencyTracer latency;
+}  // namespace local_data
+
+std::size_t latency_histogram::bucket(const std::int64_t& value) noexcept {
+    const auto& clamped = static_cast<std::uint64_t>(std::clamp<std::int64_t>(value, 0, max_value));
+    if (clamped < static_cast<std::uint64_t>(sub_bucket_count)) {
+        return static_cast<std::size_t>(clamped);
+    }
+
+    // The top sub_bucket_bits + 1 bits pick the bucket, the rest is rounding.
+    const std::size_t shift  = std::bit_width(clamped) - 1 - sub_bucket_bits;
+    const std::size_t offset = (clamped >> shift) - static_cast<std::uint64_t>(sub_bucket_count);
+    return (shift + 1) * static_cast<std::size_t>(sub_bucket_count) + offset;
+}
+
+std::int64_t latency_histogram::highest_value(const std::size_t& bucket) noexcept {
+    const auto& count = static_cast<std::size_t>(sub_bucket_count);
+    if (bucket < count) {
+        return static_cast<std::int64_t>(bucket);
+    }
+
+    const auto& shift  = bucket / count - 1;
+    const auto& lowest = static_cast<std::int64_t>(count + bucket % count) << shift;
+    return lowest + (std::int64_t{1} << shift) - 1;
+}
+
+void latency_histogram::record(const std::int64_t& value_ns) noexcept {
+    const std::int64_t value = std::clamp<std::int64_t>(value_ns, 0, max_value);
+    ++m_buckets[bucket(value)];
+    ++m_count;
+    m_sum += static_cast<std::uint64_t>(value);
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+}
+
+void latency_histogram::reset() noexcept {
+    *this = latency_histogram{};
+}
+
+std::int64_t latency_histogram::percentile(const double& quantile) const noexcept {
+    if (m_count == 0) {
+        return 0;
+    }
+
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(m_count))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::min(highest_value(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+void LatencyTracer::painted(pending_t& pending, const std::int64_t& start_ns, const std::int64_t& end_ns) noexcept {
+    if (pending.empty()) {
+        return;
+    }
+
+    for (const auto& event : pending) {
+        m_histograms[static_cast<std::size_t>(stage::queue)].record(event.dequeue - event.hook);
+        m_histograms[static_cast<std::size_t>(stage::paint_start)].record(start_ns - event.hook);
+        m_histograms[static_cast<std::size_t>(stage::paint_end)].record(end_ns - event.hook);
+    }
+    m_histograms[static_cast<std::size_t>(stage::paint)].record(end_ns - start_ns);
+    pending.clear();
+}
+
+void LatencyTracer::reset() noexcept {
+    for (auto& histogram : m_histograms) {
+        histogram.reset();
+    }
+}
+
+std::string LatencyTracer::report() const {
+    static constexpr double ns_per_us = static_cast<double>(event_clock::ns_per_us);
+    const auto& us = [](const std::int64_t& value) { return static_cast<double>(value) / ns_per_us; };
+
+    std::string result = "stage                    count        p50        p99       p999        max  (us)\n";
+    std::array<char, 128> line{};
+    for (std::size_t i = 0; i < stage_count; ++i) {
+        const auto& histogram = m_histograms[i];
+        std::snprintf(line.data(), line.size(), "%-20s %9llu %10.1f %10.1f %10.1f %10.1f\n", stage_names[i].data(),
+            static_cast<unsigned long long>(histogram.count()), us(histogram.percentile(0.5)), us(histogram.percentile(0.99)),
+            us(histogram.percentile(0.999)), us(histogram.max()));
+        result += line.data();
+    }
+    return result;
+}
+
+bool LatencyTracer::dump(const std::filesystem::path& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    out << report();
+    return static_cast<bool>(out);
+}
@@ -16,10 +16,14 @@
 // with this program; if not, write to the Free Software Foundation, Inc.,
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
+#include <vnepogodin/heatmap.hpp>
+#include <vnepogodin/latency_tracer.hpp>
 #include <vnepogodin/logger.hpp>
 #include <vnepogodin/mainwindow.hpp>
+#include <vnepogodin/motion_sampler.hpp>
 #include <vnepogodin/utils.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 #include <QByteArray>
@@ -37,6 +41,15 @@ void MainWindow::createMenu() noexcept {
         if (m_process_settings->state() == QProcess::NotRunning)
             m_process_settings->open();
     });
+
+    auto* debug_menu = m_tray_menu->addMenu("Debug");
+    debug_menu->addAction("Dump input latency", [&] {
+        dumpLatency();
+    });
+    debug_menu->addAction("Reset input latency", [&] {
+        local_data::latency.reset();
+    });
+
     m_tray_menu->addAction("Quit", [&] {
         QApplication::quit();
     });
@@ -103,7 +116,43 @@ MainWindow::MainWindow(QWidget* parent)
   : QMainWindow(parent) {
     m_ui->setupUi(this);
     m_process_settings = std::make_unique<QProcess>(this);
-    m_uiohock          = std::thread(uiohook::start);
+    m_frame_scheduler  = std::make_unique<FrameScheduler>();
+    m_stats_publisher  = std::make_unique<StatsPublisher>();
+
+    // Repaint overlays only when the hook reports a state change
+    uiohook::set_notify_proc(&FrameScheduler::notify_proc, m_frame_scheduler.get());
+    connect(m_frame_scheduler.get(), &FrameScheduler::frame, m_ui->keyboard, &Overlay::refresh);
+    connect(m_frame_scheduler.get(), &FrameScheduler::frame, m_ui->mouse, &Overlay::refresh);
+    connect(m_frame_scheduler.get(), &FrameScheduler::frame, m_stats_publisher.get(), &StatsPublisher::wake);
+
+    // Key log rotation, sizes in MiB
+    QSettings settings(QSettings::UserScope);
+    static constexpr std::uint32_t mib_shift = 20;
+    session_log::rotation_policy log_policy{};
+    log_policy.max_size  = settings.value("logRotateSize", static_cast<qulonglong>(log_policy.max_size >> mib_shift)).toULongLong() << mib_shift;
+    log_policy.retention = settings.value("logRetention", static_cast<qulonglong>(log_policy.retention >> mib_shift)).toULongLong() << mib_shift;
+    log_policy.compress  = settings.value("logCompress", log_policy.compress).toBool();
+    uiohook::set_log_policy(log_policy);
+
+    // Mouse motion sampling in milliseconds, 0 keeps every event
+    static constexpr std::int64_t us_per_ms = 1000;
+    const auto& motion_interval = settings.value("motionInterval", static_cast<qlonglong>(MotionSampler::default_interval_us / us_per_ms)).toLongLong();
+    uiohook::set_motion_interval(std::max<std::int64_t>(motion_interval, 0) * us_per_ms);
+
+    // Cursor heatmap over the whole desktop, carried over from earlier runs on the same desktop
+    const auto& desktop = QApplication::desktop()->geometry();
+    local_data::heatmap.set_geometry({desktop.x(), desktop.y(), desktop.width(), desktop.height()});
+    local_data::heatmap.load(heatmap_file::default_path());
+    m_heatmap_timer.setInterval(heatmap_save_interval_ms);
+    connect(&m_heatmap_timer, &QTimer::timeout, this, &MainWindow::saveHeatmap);
+    m_heatmap_timer.start();
+
+    // Input capture, "evdev" reads /dev/input directly on Linux
+    uiohook::set_desktop(static_cast<std::int16_t>(desktop.x()), static_cast<std::int16_t>(desktop.y()), static_cast<std::int16_t>(desktop.width()), static_cast<std::int16_t>(desktop.height()));
+    if (settings.value("captureBackend").toString() == QLatin1String("evdev")) {
+        uiohook::set_backend(uiohook::backend::evdev);
+    }
+    m_uiohock = std::thread(uiohook::start);
 
     setAttribute(Qt::WA_TranslucentBackground);
     setAttribute(Qt::WA_NativeWindow);
@@ -145,7 +194,6 @@ MainWindow::MainWindow(QWidget* parent)
     m_tray_icon->setIcon(QIcon("icon.png"));
     m_tray_icon->show();
 
-    QSettings settings(QSettings::UserScope);
     nlohmann::json json;
     detail::to_object(&settings, json);
     utils::load_key(json, m_ui->keyboard, "hideKeyboard");
@@ -163,6 +211,26 @@ MainWindow::MainWindow(QWidget* parent)
     connect(QCoreApplication::instance(), &QApplication::aboutToQuit, this, &MainWindow::close);
 }
 
+void MainWindow::saveHeatmap() {
+    if (!local_data::heatmap.save(heatmap_file::default_path())) {
+        std::cerr << "Failed to save the cursor heatmap\n";
+    }
+}
+
+void MainWindow::dumpLatency() {
+    const auto& path = LatencyTracer::default_path();
+    if (!local_data::latency.dump(path)) {
+        std::cerr << "Failed to write the latency report\n";
+        return;
+    }
+
+    static constexpr double ns_per_ms = static_cast<double>(event_clock::ns_per_ms);
+    const auto& total = local_data::latency.histogram(LatencyTracer::stage::paint_end);
+    const auto& ms    = [&total](const double& quantile) { return QString::number(static_cast<double>(total.percentile(quantile)) / ns_per_ms, 'f', 2); };
+    m_tray_icon->showMessage("Input latency",
+        QString("Key to paint p50 %1 ms, p99 %2 ms, p999 %3 ms\nSaved to %4").arg(ms(0.5), ms(0.99), ms(0.999), QString::fromStdString(path.string())));
+}
+
 void MainWindow::closeEvent(QCloseEvent* event) {
     stop_process(m_process_settings.get());
     if (m_recorder) {
@@ -174,6 +242,15 @@ void MainWindow::closeEvent(QCloseEvent* event) {
         uiohook::stop();
         m_uiohock.join();
     }
+    for (const Overlay* overlay : std::array<const Overlay*, 2>{m_ui->keyboard, m_ui->mouse}) {
+        if (overlay->droppedEvents() > 0) {
+            uiohook::logger_proc(LOG_LEVEL_WARN, "[overlay] %s fell behind the event bus, %llu events dropped.\n", qPrintable(overlay->objectName()),
+                static_cast<unsigned long long>(overlay->droppedEvents()));
+        }
+    }
+    uiohook::set_notify_proc(nullptr, nullptr);
+    m_heatmap_timer.stop();
+    saveHeatmap();
 
     QWidget::closeEvent(event);
 }
@@ -0,0 +1,96 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/motion_sampler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vnepogodin;
+
+namespace local_data {
+MotionSampler motion;
+}  // namespace local_data
+
+bool MotionSampler::add(const timed_event& event, timed_event& out) noexcept {
+    static constexpr float ns_per_second = 1e9F;
+
+    const auto& x       = event.event.data.mouse.x;
+    const auto& y       = event.event.data.mouse.y;
+    const auto& time_ns = event.time_ns;
+    if (m_current.events == 0) {
+        m_current.begin = time_ns;
+    }
+
+    if (m_has_position) {
+        const auto& dx       = static_cast<std::int32_t>(x) - m_x;
+        const auto& dy       = static_cast<std::int32_t>(y) - m_y;
+        const auto& distance = std::hypot(static_cast<float>(dx), static_cast<float>(dy));
+        m_current.dx += dx;
+        m_current.dy += dy;
+        m_current.path += distance;
+
+        // Events sharing a timestamp are measured together with the next one.
+        m_unclocked_path += distance;
+        if (time_ns > m_last_time) {
+            const auto& speed   = m_unclocked_path * ns_per_second / static_cast<float>(time_ns - m_last_time);
+            m_current.max_speed = std::max(m_current.max_speed, speed);
+            m_unclocked_path    = 0.F;
+            m_last_time         = time_ns;
+        }
+    } else {
+        m_last_time = time_ns;
+    }
+    m_x            = x;
+    m_y            = y;
+    m_has_position = true;
+
+    ++m_current.events;
+    m_current.end = time_ns;
+    m_pending     = event;
+    m_has_pending = true;
+    m_published.store(m_current);
+
+    if (time_ns - m_current.begin < m_interval_ns) {
+        return false;
+    }
+    return flush(out);
+}
+
+bool MotionSampler::flush(timed_event& out) noexcept {
+    if (!m_has_pending) {
+        return false;
+    }
+
+    out           = m_pending;
+    m_has_pending = false;
+    close();
+    return true;
+}
+
+bool MotionSampler::flush_due(const std::int64_t& now_ns, timed_event& out) noexcept {
+    if (!m_has_pending || now_ns < deadline()) {
+        return false;
+    }
+    return flush(out);
+}
+
+void MotionSampler::close() noexcept {
+    // add() published it already.
+    m_current = {};
+}
@@ -17,9 +17,11 @@
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include <vnepogodin/overlay.hpp>
+#include <vnepogodin/utils.hpp>
 
 #include <cmath>
 
+#include <QPaintEvent>
 #include <QPainter>
 #include <QString>
 #include <QSvgRenderer>
@@ -33,8 +35,69 @@ Overlay::Overlay(QWidget* parent) : QWidget(parent) {
     connect();
 }
 
-void Overlay::paintEvent(QPaintEvent*) {
-    // Initialize renderer with base asset
+void Overlay::refresh() {
+    // Traces of earlier calls may still wait for their paint.
+    const auto& traced = static_cast<std::ptrdiff_t>(m_traces.size());
+    (void)utils::handle_event(handler.get(), cursor, [this](const timed_event& captured) {
+        if (isVisible() && isTraced(captured.event)) {
+            local_data::latency.dequeued(m_traces, captured, event_clock::now());
+        }
+    });
+    const auto& state = handler->snapshot();
+    if (state.keyboard == m_state.keyboard && state.mouse == m_state.mouse) {
+        // Nothing will be painted for them.
+        m_traces.erase(m_traces.begin() + traced, m_traces.end());
+        return;
+    }
+
+    const auto before = m_state;
+    m_state           = state;
+
+    if (!connected || m_base.size() != size()) {
+        update();
+        return;
+    }
+
+    const auto& corner  = locateCorner(m_base_size, size());
+    const double& scale = getScale(m_base_size, size());
+    const auto& region  = changedRegion(before, m_state, corner, scale);
+    if (region.isEmpty()) {
+        m_traces.erase(m_traces.begin() + traced, m_traces.end());
+    }
+    update(region);
+}
+
+void Overlay::paintEvent(QPaintEvent* event) {
+    const auto& paint_start = event_clock::now();
+    if (m_base.size() != size()) {
+        renderBase();
+    }
+
+    // Restore base svg under the dirty area only
+    m_paint_region = event->region();
+    {
+        QPainter painter(this);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const auto& rect : m_paint_region) {
+            painter.drawImage(rect, m_base, rect);
+        }
+    }
+
+    if (connected) {
+        const auto& corner  = locateCorner(m_base_size, size());
+        const double& scale = getScale(m_base_size, size());
+        paintFeatures(this, corner, scale);
+    }
+    local_data::latency.painted(m_traces, paint_start, event_clock::now());
+}
+
+void Overlay::resizeEvent(QResizeEvent* event) {
+    m_base = QImage();
+    m_sprites.invalidate();
+    QWidget::resizeEvent(event);
+}
+
+void Overlay::renderBase() {
     QSvgRenderer renderer;
 
     if (connected)
@@ -43,17 +106,13 @@ void Overlay::paintEvent(QPaintEvent*) {
         renderer.load(QString(getSvgPath()) + "disconnected.svg");
 
     renderer.setAspectRatioMode(Qt::KeepAspectRatio);
+    m_base_size = renderer.defaultSize();
 
-    // Paint base svg on widget
-    QPainter painter(this);
-    renderer.render(&painter);
-    renderer.setViewBox(QRectF(0, 0, this->width(), this->height()));
+    m_base = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+    m_base.fill(Qt::transparent);
 
-    if (connected) {
-        const auto& corner  = locateCorner(renderer.defaultSize(), renderer.viewBox().size());
-        const double& scale = getScale(renderer.defaultSize(), renderer.viewBox().size());
-        paintFeatures(this, corner, scale);
-    }
+    QPainter painter(&m_base);
+    renderer.render(&painter);
 }
 
 void Overlay::paintFeatures(QPaintDevice* device, const QPoint& corner, const double& scale) {
@@ -91,42 +150,38 @@ double Overlay::getScale(const QSize& defaultSize, const QSize& viewBox) {
     return width / static_cast<double>(defaultSize.width());
 }
 
-bool Overlay::connect() noexcept {
-    if (poll.joinable())
-        poll.join();
+bool Overlay::isTraced(const uiohook_event& event) const noexcept {
+    switch (event.type) {
+    case EVENT_KEY_PRESSED:
+    case EVENT_KEY_RELEASED:
+        return inputDevice() == layout::device::keyboard;
+    case EVENT_MOUSE_PRESSED:
+    case EVENT_MOUSE_RELEASED:
+        return inputDevice() == layout::device::mouse;
+    default:
+        return false;
+    }
+}
 
+bool Overlay::connect() noexcept {
     connected = true;
-    poll      = std::thread(&Overlay::paintLoop, this);
-
     return true;
 }
 
-void Overlay::paintLoop() {
-    while (connected) {
-        update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000 / refresh_rate));
+Overlay::~Overlay() = default;
+
+void Overlay::paintAsset(const std::string_view& name, const QPoint& place, QPaintDevice* device, const double& scale) {
+    if (!m_paint_region.intersects(assetRect(name, place, scale))) {
+        return;
     }
+    m_sprites.draw(device, place, getSvgPath(), name, scale);
 }
 
-Overlay::~Overlay() {
-    connected = false;
-    poll.join();
+QRect Overlay::assetRect(const std::string_view& name, const QPoint& place, const double& scale) {
+    return {place, m_sprites.find(getSvgPath(), name, scale).size()};
 }
 
-void Overlay::paintAsset(std::string name, const QPoint& place, QPaintDevice* device, const double& scale) {
-    name = getSvgPath() + name + ".svg";
-    QSvgRenderer renderer;
-    renderer.load(QString(name.c_str()));
-
-    const int& width  = static_cast<int>(std::round(static_cast<double>(renderer.defaultSize().width()) * scale));
-    const int& height = static_cast<int>(std::round(static_cast<double>(renderer.defaultSize().height()) * scale));
-
-    QImage image(width, height, QImage::Format_ARGB32);
-    image.fill(Qt::transparent);
-
-    QPainter imagePainter(&image);
-    renderer.render(&imagePainter);
-
-    QPainter painter(device);
-    painter.drawImage(place, image);
+QPoint Overlay::placeAsset(const QPoint& pos, const QPoint& corner, const double& scale) noexcept {
+    return {static_cast<int>(std::round(static_cast<double>(pos.x()) * scale)) + corner.x(),
+        static_cast<int>(std::round(static_cast<double>(pos.y()) * scale)) + corner.y()};
 }
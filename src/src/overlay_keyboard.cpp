@@ -17,45 +17,37 @@
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include <vnepogodin/overlay_keyboard.hpp>
-#include <vnepogodin/utils.hpp>
-
-#include <cmath>
+#include <vnepogodin/key_layout.hpp>
 
 using namespace vnepogodin;
 
+namespace {
+static constexpr auto source = layout::device::keyboard;
+}  // namespace
+
 const char* OverlayKeyboard::getSvgPath() const noexcept {
     return ":keyboard/";
 }
 
-void OverlayKeyboard::paintButtons(QPaintDevice* device, const QPoint& corner, const double& scale) {
-#ifndef _WIN32
-    static constexpr frozen::unordered_map<uint32_t, std::pair<std::string_view, QPoint>, 9> button_map = {
-#else
-    static std::unordered_map<uint32_t, std::pair<std::string_view, QPoint>> button_map = {
-#endif
-        {utils::key_code::W, {"w_button", {384, 0}}},
-        {utils::key_code::A, {"a_button", {169, 182}}},
-        {utils::key_code::S, {"s_button", {338, 182}}},
-        {utils::key_code::D, {"d_button", {508, 182}}},
-        {utils::key_code::Q, {"q_button", {210, 0}}},
-        {utils::key_code::E, {"e_button", {552, 0}}},
-        {utils::key_code::SHIFT, {"shift_button", {0, 182}}},
-        {utils::key_code::CONTROL, {"ctrl_button", {23, 360}}},
-        {utils::key_code::SPACEBAR, {"space_button", {192, 360}}}
-    };
+layout::device OverlayKeyboard::inputDevice() const noexcept {
+    return source;
+}
 
-    std::lock_guard<std::mutex> lock(data_mutex);
-    (void)utils::handle_event(handler.get());
-    for (const auto& [button, value] : handler->keyboard) {
-        if (!value) {
+void OverlayKeyboard::paintButtons(QPaintDevice* device, const QPoint& corner, const double& scale) {
+    for (const auto& key : layout::keys) {
+        if (key.source != source || !state().is_pressed(key)) {
             continue;
         }
-        for (const auto& [mask, asset] : button_map) {
-            if (mask == button) {
-                const QPoint& location = QPoint(static_cast<int>(std::round(static_cast<double>(asset.second.x()) * scale)) + corner.x(),
-                    static_cast<int>(std::round(static_cast<double>(asset.second.y()) * scale)) + corner.y());
-                paintAsset(asset.first.data(), location, device, scale);
-            }
+        paintAsset(key.name, placeAsset({key.x, key.y}, corner, scale), device, scale);
+    }
+}
+
+QRegion OverlayKeyboard::changedRegion(const input_snapshot& before, const input_snapshot& after, const QPoint& corner, const double& scale) {
+    QRegion region;
+    for (const auto& key : layout::keys) {
+        if (key.source == source && before.is_pressed(key) != after.is_pressed(key)) {
+            region += assetRect(key.name, placeAsset({key.x, key.y}, corner, scale), scale);
         }
     }
+    return region;
 }
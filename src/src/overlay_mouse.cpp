@@ -17,43 +17,39 @@
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include <vnepogodin/overlay_mouse.hpp>
-#include <vnepogodin/utils.hpp>
-
-#include <cmath>
+#include <vnepogodin/key_layout.hpp>
 
 using namespace vnepogodin;
 
+namespace {
+static constexpr auto source = layout::device::mouse;
+}  // namespace
+
 const char* OverlayMouse::getSvgPath() const noexcept {
     return ":mouse/";
 }
 
-void OverlayMouse::paintButtons(QPaintDevice* device, const QPoint& corner, const double& scale) {
-#ifndef _WIN32
-    static constexpr frozen::unordered_map<uint8_t, std::pair<std::string_view, QPoint>, 5> button_map = {
-#else
-    static std::unordered_map<uint8_t, std::pair<std::string_view, QPoint>> button_map = {
-#endif
-        {utils::key_code::LBUTTON, {"left_button", {10, 0}}},
-        {utils::key_code::RBUTTON, {"right_button", {512, 0}}},
-        {utils::key_code::MBUTTON, {"middle_button", {415, 273}}},
-        {utils::key_code::X1BUTTON, {"x_button", {2, 735}}},
-        {utils::key_code::X2BUTTON, {"x_button", {41, 960}}}
-    };
+layout::device OverlayMouse::inputDevice() const noexcept {
+    return source;
+}
 
-    std::lock_guard<std::mutex> lock(data_mutex);
-    (void)utils::handle_event(handler.get());
-    for (const auto& [button, value] : handler->mouse) {
-        if (!value) {
+void OverlayMouse::paintButtons(QPaintDevice* device, const QPoint& corner, const double& scale) {
+    for (const auto& key : layout::keys) {
+        if (key.source != source || !state().is_pressed(key)) {
             continue;
         }
-        for (const auto& [mask, asset] : button_map) {
-            if (mask == button) {
-                const QPoint& location = QPoint(static_cast<int>(std::round(static_cast<double>(asset.second.x()) * scale)) + corner.x(),
-                    static_cast<int>(std::round(static_cast<double>(asset.second.y()) * scale)) + corner.y());
-                paintAsset(asset.first.data(), location, device, scale);
-            }
+        paintAsset(key.name, placeAsset({key.x, key.y}, corner, scale), device, scale);
+    }
+}
+
+QRegion OverlayMouse::changedRegion(const input_snapshot& before, const input_snapshot& after, const QPoint& corner, const double& scale) {
+    QRegion region;
+    for (const auto& key : layout::keys) {
+        if (key.source == source && before.is_pressed(key) != after.is_pressed(key)) {
+            region += assetRect(key.name, placeAsset({key.x, key.y}, corner, scale), scale);
         }
     }
+    return region;
 }
 
 void OverlayMouse::paintTouch(QPaintDevice* /*device*/, QPoint /*corner*/, double /*scale*/) {
@@ -0,0 +1,212 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/process_watcher.hpp>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <tlhelp32.h>  // PROCESSENTRY32W, CreateToolhelp32Snapshot, Process32FirstW, Process32NextW
+#else
+#include <charconv>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <optional>
+#include <string>
+
+using namespace vnepogodin;
+
+namespace {
+ProcessWatcher::game_index_t find_game(const std::string_view& exe) noexcept {
+    for (std::size_t i = 0; i < detail::tracked_games.size(); ++i) {
+        if (detail::tracked_games[i].exe == exe) {
+            return static_cast<ProcessWatcher::game_index_t>(i);
+        }
+    }
+    return ProcessWatcher::npos;
+}
+
+#ifndef _WIN32
+/**
+ * Field 22 of /proc/<pid>/stat, in clock ticks since boot.
+ * @return nullopt if the process is gone.
+ */
+std::optional<std::uint64_t> read_start_time(const std::string_view& pid) {
+    const std::string& path = "/proc/" + std::string(pid) + "/stat";
+    const int fd            = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    std::array<char, 1024> buf{};
+    const auto& size = ::read(fd, buf.data(), buf.size());
+    ::close(fd);
+    if (size <= 0) {
+        return std::nullopt;
+    }
+
+    // comm (field 2) may hold spaces and parentheses, count fields after its closing one.
+    std::string_view stat(buf.data(), static_cast<std::size_t>(size));
+    const auto& comm_end = stat.rfind(')');
+    if (comm_end == std::string_view::npos) {
+        return std::nullopt;
+    }
+    stat.remove_prefix(comm_end + 1);
+    for (int field = 2; field < 22; ++field) {
+        const auto& space = stat.find(' ');
+        if (space == std::string_view::npos) {
+            return std::nullopt;
+        }
+        stat.remove_prefix(space + 1);
+    }
+
+    std::uint64_t start{};
+    if (std::from_chars(stat.data(), stat.data() + stat.size(), start).ec != std::errc{}) {
+        return std::nullopt;
+    }
+    return start;
+}
+
+/* Basename of argv[0], read straight from /proc/<pid>/cmdline */
+std::string read_exe(const std::string_view& pid) {
+    const std::string& path = "/proc/" + std::string(pid) + "/cmdline";
+    const int fd            = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return {};
+    }
+
+    std::array<char, 256> buf{};
+    const auto& size = ::read(fd, buf.data(), buf.size());
+    ::close(fd);
+    if (size <= 0) {
+        return {};
+    }
+
+    // argv[0] ends at the first NUL, the rest are arguments.
+    std::string_view exe(buf.data(), static_cast<std::size_t>(size));
+    exe = exe.substr(0, exe.find('\0'));
+    if (const auto& slash = exe.rfind('/'); slash != std::string_view::npos) {
+        exe.remove_prefix(slash + 1);
+    }
+    return std::string(exe);
+}
+#endif
+}  // namespace
+
+template <class StartProc, class ExeProc>
+void ProcessWatcher::visit(const std::uint32_t& pid, const std::uint64_t& inode, StartProc&& start_proc, ExeProc&& exe_proc) {
+    const auto& [it, inserted] = m_processes.try_emplace(pid);
+    it->second.seen            = m_epoch;
+    if (!inserted && it->second.inode == inode) {
+        return;
+    }
+
+    // procfs may also hand out a new inode to the same process.
+    const auto& start = start_proc();
+    if (!inserted && start && it->second.start == *start) {
+        it->second.inode = inode;
+        return;
+    }
+
+    // The pid was reused since the last refresh, forget the exited process.
+    if (!inserted && it->second.game != npos) {
+        --m_running[it->second.game];
+    }
+    if (!start) {
+        m_processes.erase(it);
+        return;
+    }
+
+    it->second.inode = inode;
+    it->second.start = *start;
+    it->second.game  = find_game(exe_proc());
+    if (it->second.game != npos) {
+        ++m_running[it->second.game];
+    }
+}
+
+void ProcessWatcher::sweep() {
+    for (auto it = m_processes.begin(); it != m_processes.end();) {
+        if (it->second.seen == m_epoch) {
+            ++it;
+            continue;
+        }
+        if (it->second.game != npos) {
+            --m_running[it->second.game];
+        }
+        it = m_processes.erase(it);
+    }
+}
+
+bool ProcessWatcher::refresh() {
+#ifdef _WIN32
+    // Take a snapshot of all processes in the system.
+    HANDLE hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (hProcessSnap == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // Set the size of the structure before using it.
+    PROCESSENTRY32W pe32{};
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+
+    ++m_epoch;
+    if (Process32FirstW(hProcessSnap, &pe32)) {
+        do {
+            visit(pe32.th32ProcessID, 0, [] { return std::optional<std::uint64_t>{0}; }, [&pe32] {
+                const std::wstring wide = pe32.szExeFile;
+                return std::string(wide.begin(), wide.end());
+            });
+        } while (Process32NextW(hProcessSnap, &pe32));
+    }
+    CloseHandle(hProcessSnap);
+#else
+    DIR* dir_proc = opendir("/proc/");
+    if (dir_proc == nullptr) {
+        return false;
+    }
+
+    ++m_epoch;
+    while (const struct dirent* dir_entity = readdir(dir_proc)) {
+        if (dir_entity->d_type != DT_DIR) {
+            continue;
+        }
+
+        // Only numeric entries are processes.
+        const std::string_view name(dir_entity->d_name);
+        std::uint32_t pid{};
+        if (const auto& [end, ec] = std::from_chars(name.data(), name.data() + name.size(), pid); ec != std::errc{} || end != name.data() + name.size()) {
+            continue;
+        }
+        visit(pid, dir_entity->d_ino, [&name] { return read_start_time(name); }, [&name] { return read_exe(name); });
+    }
+    closedir(dir_proc);
+#endif
+    sweep();
+
+    game_index_t game = npos;
+    for (std::size_t i = 0; i < m_running.size(); ++i) {
+        if (m_running[i] > 0) {
+            game = static_cast<game_index_t>(i);
+            break;
+        }
+    }
+    return m_current.exchange(game, std::memory_order_acq_rel) != game;
+}
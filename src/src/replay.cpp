@@ -0,0 +1,171 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include <vnepogodin/frame_scheduler.hpp>
+#include <vnepogodin/latency_tracer.hpp>
+#include <vnepogodin/overlay_keyboard.hpp>
+#include <vnepogodin/overlay_mouse.hpp>
+#include <vnepogodin/replay_source.hpp>
+#include <vnepogodin/uiohook_helper.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QTimer>
+
+using namespace vnepogodin;
+
+namespace {
+/* Overlay size on the offscreen desktop */
+static constexpr int overlay_size = 256;
+/* How long the overlays get to catch up once everything was dispatched */
+static constexpr int drain_ms = 500;
+
+/* Peak resident set size in bytes, 0 where unknown */
+static std::uint64_t peak_rss() noexcept {
+#ifndef _WIN32
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    static constexpr std::uint64_t bytes_per_kib = 1024;
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * bytes_per_kib;
+#endif
+#else
+    return 0;
+#endif
+}
+}  // namespace
+
+/**
+ * overlay-replay: feeds a recorded or synthetic event stream through
+ * uiohook::dispatch_proc into both overlays, without a display or a hook,
+ * and reports throughput, frame times and memory.
+ */
+auto main(int argc, char** argv) -> std::int32_t {
+    // Headless unless a platform is asked for explicitly.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QCoreApplication::setApplicationName("overlay-replay");
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays input through the overlay pipeline and reports how it keeps up.");
+    parser.addHelpOption();
+    const QCommandLineOption log_option("log", "Replay a session log instead of synthetic input.", "path");
+    const QCommandLineOption count_option("count", "Synthetic events to generate.", "n", "100000");
+    const QCommandLineOption motion_option("motion-rate", "Synthetic mouse motion per second.", "hz", "1000");
+    const QCommandLineOption press_option("press-rate", "Synthetic presses per second.", "hz", "20");
+    const QCommandLineOption seed_option("seed", "Seed of the synthetic stream.", "n", "1");
+    const QCommandLineOption speed_option("speed", "Playback speed, 1 is real time and 0 as fast as possible.", "factor", "1");
+    parser.addOptions({log_option, count_option, motion_option, press_option, seed_option, speed_option});
+    parser.process(app);
+
+    replay_source::stream events;
+    if (parser.isSet(log_option)) {
+        events = replay_source::load_log(parser.value(log_option).toStdString());
+    } else {
+        replay_source::synthetic_options options{};
+        options.count       = parser.value(count_option).toULongLong();
+        options.motion_rate = parser.value(motion_option).toUInt();
+        options.press_rate  = parser.value(press_option).toUInt();
+        options.seed        = parser.value(seed_option).toUInt();
+        events              = replay_source::synthesize(options);
+    }
+    if (events.empty()) {
+        std::fprintf(stderr, "Nothing to replay\n");
+        return 1;
+    }
+    const double& speed = std::max(parser.value(speed_option).toDouble(), 0.0);
+
+    OverlayKeyboard keyboard;
+    OverlayMouse mouse;
+    keyboard.setFixedSize(overlay_size, overlay_size);
+    mouse.setFixedSize(overlay_size * 2 / 3, overlay_size * 2 / 3);
+    keyboard.show();
+    mouse.show();
+
+    // Same wiring as MainWindow, minus the hook.
+    FrameScheduler scheduler;
+    uiohook::set_notify_proc(&FrameScheduler::notify_proc, &scheduler);
+    QObject::connect(&scheduler, &FrameScheduler::frame, &keyboard, &Overlay::refresh);
+    QObject::connect(&scheduler, &FrameScheduler::frame, &mouse, &Overlay::refresh);
+
+    latency_histogram frame_intervals;
+    std::uint64_t frames    = 0;
+    std::int64_t last_frame = 0;
+    QObject::connect(&scheduler, &FrameScheduler::frame, [&] {
+        const auto& now = event_clock::now();
+        if (frames++ > 0) {
+            frame_intervals.record(now - last_frame);
+        }
+        last_frame = now;
+    });
+
+    std::int64_t dispatch_ns = 0;
+    std::thread feeder([&] {
+        const auto& start = event_clock::now();
+        for (const auto& captured : events) {
+            if (speed > 0) {
+                const auto& due = start + static_cast<std::int64_t>(static_cast<double>(captured.time_ns) / speed);
+                std::this_thread::sleep_until(std::chrono::steady_clock::time_point{
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds{due})});
+            }
+            auto event = captured.event;
+            uiohook::dispatch_proc(&event);
+        }
+        dispatch_ns = event_clock::now() - start;
+
+        QMetaObject::invokeMethod(&app, [&app] {
+            QTimer::singleShot(drain_ms, &app, &QCoreApplication::quit);
+        }, Qt::QueuedConnection);
+    });
+    const auto& exit_code = app.exec();
+    feeder.join();
+    uiohook::set_notify_proc(nullptr, nullptr);
+
+    static constexpr double ns_per_second = 1e9;
+    static constexpr double ns_per_ms     = static_cast<double>(event_clock::ns_per_ms);
+    static constexpr double bytes_per_mib = 1024.0 * 1024.0;
+    const auto& seconds                   = static_cast<double>(dispatch_ns) / ns_per_second;
+    const auto& ms                        = [](const std::int64_t& value) { return static_cast<double>(value) / ns_per_ms; };
+
+    std::printf("events     %zu in %.3f s, %.0f events/s (stream %.3f s, speed %g)\n", events.size(), seconds,
+        static_cast<double>(events.size()) / std::max(seconds, 1e-9), static_cast<double>(events.back().time_ns) / ns_per_second, speed);
+    std::printf("dropped    keyboard %llu, mouse %llu\n", static_cast<unsigned long long>(keyboard.droppedEvents()),
+        static_cast<unsigned long long>(mouse.droppedEvents()));
+    std::printf("frames     %llu, interval p50 %.2f ms, p99 %.2f ms, max %.2f ms\n", static_cast<unsigned long long>(frames),
+        ms(frame_intervals.percentile(0.5)), ms(frame_intervals.percentile(0.99)), ms(frame_intervals.max()));
+    std::printf("peak RSS   %.1f MiB\n\n", static_cast<double>(peak_rss()) / bytes_per_mib);
+    std::printf("%s", local_data::latency.report().c_str());
+    return exit_code;
+}
@@ -0,0 +1,165 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include <vnepogodin/key_layout.hpp>
+#include <vnepogodin/replay_source.hpp>
+#include <vnepogodin/session_log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <random>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+using namespace vnepogodin;
+
+namespace {
+/* Longer idle stretches in a log are cut down to this */
+static constexpr std::int64_t max_gap_ns = 1000 * event_clock::ns_per_ms;
+
+static timed_event make_key_event(const layout::key_info& key, const event_type& type, const std::int64_t& time_ns) noexcept {
+    timed_event result{};
+    result.event.type = type;
+    result.event.time = static_cast<std::uint64_t>(time_ns / event_clock::ns_per_ms);
+    if (key.source == layout::device::keyboard) {
+        result.event.data.keyboard.keycode = key.code;
+    } else {
+        result.event.data.mouse.button = key.code;
+    }
+    result.time_ns = time_ns;
+    return result;
+}
+}  // namespace
+
+replay_source::stream replay_source::load_log(const std::filesystem::path& path) {
+    QFile file(QString::fromStdString(path.string()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QByteArray data = file.readAll();
+    if (path.extension() == session_log::compressed_suffix) {
+        data = qUncompress(data);
+    }
+
+    session_log::buffer_reader log(data.constData(), static_cast<std::size_t>(data.size()));
+    session_log::block_view block{};
+    session_log::segment_view segment{};
+
+    // Records are in order, the writer never logs time going backwards.
+    stream result;
+    std::int64_t offset    = 0;
+    std::int64_t last_time = 0;
+    for (session_log::chunk_type type{}; (type = log.next(block, segment)) != session_log::chunk_type::none;) {
+        if (type != session_log::chunk_type::block) {
+            continue;
+        }
+
+        std::int64_t time = block.base_time;
+        for (std::size_t i = 0; i < block.count; ++i) {
+            time += block.delta_at(i);
+            const auto& key = block.key_at(i);
+            if (key >= layout::key_count) {
+                continue;
+            }
+
+            const auto& time_ns = time * event_clock::ns_per_ms + block.fraction_at(i);
+            if (result.empty()) {
+                offset = time_ns;
+            } else if (time_ns - last_time > max_gap_ns) {
+                offset += time_ns - last_time - max_gap_ns;
+            }
+            last_time = time_ns;
+            result.push_back(make_key_event(layout::keys[key], static_cast<event_type>(block.type_at(i)), time_ns - offset));
+        }
+    }
+    return result;
+}
+
+replay_source::stream replay_source::synthesize(const synthetic_options& options) {
+    static constexpr std::int64_t ns_per_second = 1000 * event_clock::ns_per_ms;
+    static constexpr std::int64_t min_hold_ns   = 30 * event_clock::ns_per_ms;
+    static constexpr std::int64_t max_hold_ns   = 150 * event_clock::ns_per_ms;
+    /* The cursor circles the middle of a 1080p desktop once a second */
+    static constexpr double center_x = 960.0;
+    static constexpr double center_y = 540.0;
+    static constexpr double radius   = 300.0;
+
+    if (options.count == 0 || (options.motion_rate == 0 && options.press_rate == 0)) {
+        return {};
+    }
+
+    // Plain mt19937 output only, distributions differ between standard libraries.
+    std::mt19937 rng(options.seed);
+    const auto& random = [&rng](const std::int64_t& lowest, const std::int64_t& highest) {
+        return lowest + static_cast<std::int64_t>(rng() % static_cast<std::uint64_t>(highest - lowest + 1));
+    };
+
+    static constexpr std::int64_t never = std::numeric_limits<std::int64_t>::max();
+    const std::int64_t& motion_step     = (options.motion_rate > 0) ? ns_per_second / options.motion_rate : never;
+    const std::int64_t& press_step      = (options.press_rate > 0) ? ns_per_second / options.press_rate : never;
+
+    std::int64_t next_motion = (options.motion_rate > 0) ? 0 : never;
+    std::int64_t next_press  = (options.press_rate > 0) ? random(press_step / 2, press_step * 3 / 2) : never;
+    /* Release time of every held key, never when up */
+    std::array<std::int64_t, layout::key_count> release{};
+    release.fill(never);
+
+    stream result;
+    result.reserve(options.count);
+    while (result.size() < options.count) {
+        const auto& next_release = std::min_element(release.begin(), release.end());
+        const auto& time_ns      = std::min({next_motion, next_press, *next_release});
+
+        if (time_ns == *next_release) {
+            const auto& key  = layout::keys[static_cast<std::size_t>(next_release - release.begin())];
+            const auto& type = (key.source == layout::device::keyboard) ? EVENT_KEY_RELEASED : EVENT_MOUSE_RELEASED;
+            result.push_back(make_key_event(key, type, time_ns));
+            *next_release = never;
+        } else if (time_ns == next_press) {
+            const auto& idx = static_cast<std::size_t>(random(0, static_cast<std::int64_t>(layout::key_count) - 1));
+            if (release[idx] == never) {
+                const auto& key  = layout::keys[idx];
+                const auto& type = (key.source == layout::device::keyboard) ? EVENT_KEY_PRESSED : EVENT_MOUSE_PRESSED;
+                result.push_back(make_key_event(key, type, time_ns));
+                release[idx] = time_ns + random(min_hold_ns, max_hold_ns);
+            }
+            next_press = time_ns + random(press_step / 2, press_step * 3 / 2);
+        } else {
+            const bool& dragging = std::any_of(layout::keys.begin(), layout::keys.end(), [&](const layout::key_info& key) {
+                return key.source == layout::device::mouse && release[static_cast<std::size_t>(&key - layout::keys.data())] != never;
+            });
+            const auto& angle = 2.0 * std::numbers::pi * static_cast<double>(time_ns % ns_per_second) / static_cast<double>(ns_per_second);
+
+            timed_event motion{};
+            motion.event.type         = dragging ? EVENT_MOUSE_DRAGGED : EVENT_MOUSE_MOVED;
+            motion.event.time         = static_cast<std::uint64_t>(time_ns / event_clock::ns_per_ms);
+            motion.event.data.mouse.x = static_cast<std::int16_t>(std::lround(center_x + radius * std::cos(angle)));
+            motion.event.data.mouse.y = static_cast<std::int16_t>(std::lround(center_y + radius * std::sin(angle)));
+            motion.time_ns            = time_ns;
+            result.push_back(motion);
+            next_motion = time_ns + motion_step;
+        }
+    }
+    return result;
+}
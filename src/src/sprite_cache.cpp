@@ -0,0 +1,94 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/sprite_cache.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <QPainter>
+#include <QString>
+#include <QSvgRenderer>
+
+using namespace vnepogodin;
+
+QRect SpriteCache::find(const std::string_view& prefix, const std::string_view& name, const double& scale) {
+    if (scale != m_scale) {
+        invalidate();
+        m_scale = scale;
+    }
+
+    if (const auto& it = m_sprites.find(name); it != m_sprites.end()) {
+        return it->second;
+    }
+
+    const std::string& path = std::string(prefix) + std::string(name) + ".svg";
+    QSvgRenderer renderer;
+    renderer.load(QString::fromStdString(path));
+
+    const int& width  = static_cast<int>(std::round(static_cast<double>(renderer.defaultSize().width()) * scale));
+    const int& height = static_cast<int>(std::round(static_cast<double>(renderer.defaultSize().height()) * scale));
+
+    const auto& rect = allocate(QSize(width, height));
+    QPainter painter(&m_atlas);
+    renderer.render(&painter, QRectF(rect));
+
+    m_sprites.emplace(name, rect);
+    return rect;
+}
+
+void SpriteCache::draw(QPaintDevice* device, const QPoint& place, const std::string_view& prefix, const std::string_view& name, const double& scale) {
+    const auto& rect = find(prefix, name, scale);
+
+    QPainter painter(device);
+    painter.drawImage(place, m_atlas, rect);
+}
+
+void SpriteCache::invalidate() noexcept {
+    m_sprites.clear();
+    m_atlas        = QImage();
+    m_cursor       = QPoint();
+    m_shelf_height = 0;
+}
+
+QRect SpriteCache::allocate(const QSize& size) {
+    // Simple shelf packing: fill rows left to right, start a new row when full.
+    if (m_cursor.x() + size.width() > std::max(atlas_width, m_atlas.width())) {
+        m_cursor       = QPoint(0, m_cursor.y() + m_shelf_height);
+        m_shelf_height = 0;
+    }
+
+    const int& need_width  = std::max({atlas_width, m_atlas.width(), size.width()});
+    const int& need_height = m_cursor.y() + size.height();
+    if (need_width > m_atlas.width() || need_height > m_atlas.height()) {
+        QImage grown(need_width, std::max(need_height, m_atlas.height() * 2), QImage::Format_ARGB32_Premultiplied);
+        grown.fill(Qt::transparent);
+        if (!m_atlas.isNull()) {
+            QPainter painter(&grown);
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.drawImage(0, 0, m_atlas);
+        }
+        m_atlas = std::move(grown);
+    }
+
+    const QRect rect(m_cursor, size);
+    m_cursor.rx() += size.width();
+    m_shelf_height = std::max(m_shelf_height, size.height());
+    return rect;
+}
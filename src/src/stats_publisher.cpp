@@ -0,0 +1,82 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <vnepogodin/stats_publisher.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <new>
+
+using namespace vnepogodin;
+
+StatsPublisher::StatsPublisher(QObject* parent) : QObject(parent), m_memory(stats_channel::name()) {
+    static constexpr int segment_size = sizeof(stats_channel::segment);
+
+    // The segment outlives an overlay while a reader is still attached, and
+    // a crashed overlay leaves it behind. Take it over when it fits, readers
+    // see magic drop and come back once it's set again.
+    if (!m_memory.create(segment_size)) {
+        if (!m_memory.attach() || m_memory.size() < segment_size) {
+            m_memory.detach();
+            if (!m_memory.create(segment_size)) {
+                return;
+            }
+        }
+    }
+
+    m_segment = new (m_memory.data()) stats_channel::segment();
+    m_segment->magic.store(stats_channel::magic, std::memory_order_release);
+
+    m_timer.setInterval(publish_interval_ms);
+    QObject::connect(&m_timer, &QTimer::timeout, this, &StatsPublisher::publish);
+    publish();
+}
+
+StatsPublisher::~StatsPublisher() {
+    if (m_segment != nullptr) {
+        m_segment->magic.store(0, std::memory_order_release);
+        m_segment->~segment();
+    }
+}
+
+void StatsPublisher::wake() {
+    if (m_segment != nullptr && !m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void StatsPublisher::publish() {
+    const auto& apm = local_data::apm.snapshot();
+
+    motion_sample motion{};
+    if (const auto& version = local_data::motion.version(); version != m_motion_version) {
+        m_motion_version = version;
+        motion           = local_data::motion.last();
+    }
+
+    // Nothing pressed within the last minute, nothing left to decay and the mouse at rest.
+    if (std::memcmp(&apm, &m_last, sizeof(apm_snapshot)) == 0 && apm.presses(apm_window::minute) == 0 && motion.events == 0 && !m_moving) {
+        m_timer.stop();
+        return;
+    }
+
+    const auto& now = std::chrono::system_clock::now().time_since_epoch();
+    m_segment->data.store({apm, motion, std::chrono::duration_cast<std::chrono::milliseconds>(now).count()});
+    m_last   = apm;
+    m_moving = motion.events != 0;
+}
@@ -16,10 +16,19 @@
 // with this program; if not, write to the Free Software Foundation, Inc.,
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
+#include <vnepogodin/apm_counter.hpp>
+#ifdef __linux__
+#include <vnepogodin/evdev_hook.hpp>
+#endif
+#include <vnepogodin/heatmap.hpp>
+#include <vnepogodin/input_data.hpp>
+#include <vnepogodin/key_layout.hpp>
 #include <vnepogodin/logger.hpp>
+#include <vnepogodin/motion_sampler.hpp>
 #include <vnepogodin/uiohook_helper.hpp>
-#include <vnepogodin/utils.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstdarg>
 #include <cstdio>
 
@@ -27,21 +36,83 @@
 
 namespace uiohook {
 std::atomic<bool> hook_state;
-std::mutex buffer_mutex;
-vnepogodin::buffer buf;
+event_queue buf;
 
 static vnepogodin::Logger logger;
 
+static backend capture_backend = backend::native;
+/* Backend start() ended up running, stop() is called from another thread */
+static std::atomic<backend> running_backend{backend::native};
+#ifdef __linux__
+static vnepogodin::EvdevHook evdev;
+#endif
+
+static notify_proc_t notify_proc = nullptr;
+static void* notify_data         = nullptr;
+
+void set_notify_proc(notify_proc_t proc, void* user_data) noexcept {
+    notify_proc = proc;
+    notify_data = user_data;
+}
+
+void set_log_policy(const vnepogodin::session_log::rotation_policy& policy) noexcept {
+    logger.set_policy(policy);
+}
+
+void set_motion_interval(const std::int64_t& interval_us) noexcept {
+    local_data::motion.set_interval(interval_us);
+}
+
+void set_backend(const backend& source) noexcept {
+    capture_backend = source;
+}
+
+void set_desktop([[maybe_unused]] const std::int16_t& x, [[maybe_unused]] const std::int16_t& y, [[maybe_unused]] const std::int16_t& width, [[maybe_unused]] const std::int16_t& height) noexcept {
+#ifdef __linux__
+    evdev.set_bounds(x, y, width, height);
+#endif
+}
+
+static inline void notify() noexcept {
+    if (notify_proc) {
+        notify_proc(notify_data);
+    }
+}
+
 using namespace vnepogodin;
-static inline std::uint32_t handle_key(const std::uint32_t& key_stroke) {
-    for (const auto& code : utils::code_list) {
-        if (code.first == key_stroke) {
-            logger.add_key(code.second);
-            return code.first;
+static_assert(layout::key_count <= session_log::index_key_slots, "the session log index can't count every key");
+
+/* Keyboard keys the layout tracks, X11 skips the keysym lookup for every other key */
+static constexpr auto keyboard_key_count = static_cast<std::size_t>(std::count_if(layout::keys.begin(), layout::keys.end(),
+    [](const layout::key_info& key) { return key.source == layout::device::keyboard; }));
+static constexpr auto keyboard_keycodes = [] {
+    std::array<std::uint16_t, keyboard_key_count> result{};
+    std::size_t i = 0;
+    for (const auto& key : layout::keys) {
+        if (key.source == layout::device::keyboard) {
+            result[i++] = key.code;
         }
     }
+    return result;
+}();
+
+/* Keeps pending motion ahead of the event about to be pushed */
+static inline void push(const uiohook_event& event, const std::int64_t& time_ns) noexcept {
+    timed_event motion;
+    if (local_data::motion.flush(motion)) {
+        buf.push(motion);
+    }
+    buf.push({event, time_ns});
+}
 
-    return utils::key_code::UNDEFINED;
+static inline void handle_key(const layout::device& source, const std::uint16_t& code, const event_type& type, const std::int64_t& time_ns) {
+    const auto& idx = layout::key_index(source, code);
+    if (type == EVENT_KEY_PRESSED || type == EVENT_MOUSE_PRESSED) {
+        local_data::apm.add(idx, time_ns / event_clock::ns_per_ms);
+    }
+    if (idx != layout::npos) {
+        logger.add_key(idx, static_cast<std::uint8_t>(type), time_ns);
+    }
 }
 
 #ifdef __clang__
@@ -78,7 +149,9 @@ bool logger_proc(unsigned int level, const char* format, ...) {
 #endif
 
 void dispatch_proc(uiohook_event* const event) {
-    std::lock_guard<std::mutex> lock(buffer_mutex);
+    // Stamped before anything else, every consumer sees the same time.
+    const auto& time_ns = event_clock::now();
+    local_data::data.dispatch_uiohook_event(event);
 
     switch (event->type) {
     case EVENT_HOOK_ENABLED:
@@ -86,22 +159,48 @@ void dispatch_proc(uiohook_event* const event) {
         hook_state = true;
         break;
     case EVENT_MOUSE_PRESSED:
-        buf.write<uiohook_event>(*event);
-        handle_key(event->data.mouse.button);
+        push(*event, time_ns);
+        handle_key(layout::device::mouse, event->data.mouse.button, event->type, time_ns);
+        notify();
         break;
     case EVENT_KEY_PRESSED:
-        buf.write<uiohook_event>(*event);
-        handle_key(event->data.keyboard.keycode);
+        push(*event, time_ns);
+        handle_key(layout::device::keyboard, event->data.keyboard.keycode, event->type, time_ns);
+        notify();
         break;
     case EVENT_MOUSE_RELEASED:
+        push(*event, time_ns);
+        handle_key(layout::device::mouse, event->data.mouse.button, event->type, time_ns);
+        notify();
+        break;
     case EVENT_MOUSE_CLICKED:
+        push(*event, time_ns);
+        break;
     case EVENT_MOUSE_MOVED:
-    case EVENT_MOUSE_DRAGGED:
-        buf.write<uiohook_event>(*event);
+    case EVENT_MOUSE_DRAGGED: {
+        local_data::heatmap.add(event->data.mouse.x, event->data.mouse.y, time_ns);
+
+        // Motion held back since the mouse last stopped goes out on its own.
+        timed_event motion;
+        if (local_data::motion.flush_due(time_ns, motion)) {
+            buf.push(motion);
+        }
+        const bool& idle = local_data::motion.deadline() == 0;
+        if (local_data::motion.add({*event, time_ns}, motion)) {
+            buf.push(motion);
+        } else if (idle) {
+            // Wakes the stats publisher, which reads the open interval.
+            notify();
+        }
         break;
-    case EVENT_KEY_TYPED:
+    }
     case EVENT_KEY_RELEASED:
-        buf.write<uiohook_event>(*event);
+        push(*event, time_ns);
+        handle_key(layout::device::keyboard, event->data.keyboard.keycode, event->type, time_ns);
+        notify();
+        break;
+    case EVENT_KEY_TYPED:
+        push(*event, time_ns);
         break;
     default:
         break;
@@ -112,6 +211,27 @@ bool start() {
     hook_set_logger_proc(&logger_proc);
     hook_set_dispatch_proc(&dispatch_proc);
 
+    // Typed text and the wheel aren't used, so X11 neither records nor translates them.
+    hook_set_event_mask(EVENT_MASK(EVENT_KEY_PRESSED) | EVENT_MASK(EVENT_KEY_RELEASED) | EVENT_MASK_MOUSE_MOTION
+        | EVENT_MASK(EVENT_MOUSE_PRESSED) | EVENT_MASK(EVENT_MOUSE_RELEASED) | EVENT_MASK(EVENT_MOUSE_CLICKED));
+    hook_set_keycode_filter(keyboard_keycodes.data(), keyboard_keycodes.size());
+
+    if (!logger.start()) {
+        logger_proc(LOG_LEVEL_WARN, "[uiohook] Failed to open the key log, keys won't be recorded.");
+    }
+
+#ifdef __linux__
+    if (capture_backend == backend::evdev) {
+        running_backend = backend::evdev;
+        if (evdev.run(&dispatch_proc) == UIOHOOK_SUCCESS) {
+            hook_state = true;
+            return true;
+        }
+        logger_proc(LOG_LEVEL_WARN, "[uiohook] No readable device in /dev/input, falling back to the native hook.");
+    }
+#endif
+    running_backend = backend::native;
+
     const auto& status = hook_run();
 
     switch (status) {
@@ -166,13 +286,30 @@ bool start() {
     }
 }
 
+/* Closes the key log and reports how the writer kept up */
+static void close_logger() {
+    logger.close();
+
+    const auto& stats = logger.stats();
+    logger_proc((stats.dropped > 0) ? LOG_LEVEL_WARN : LOG_LEVEL_INFO,
+        "[logger] %llu keys written in %llu blocks, %llu dropped, queue peaked at %llu of %zu.\n", static_cast<unsigned long long>(stats.written),
+        static_cast<unsigned long long>(stats.blocks), static_cast<unsigned long long>(stats.dropped),
+        static_cast<unsigned long long>(stats.queue_high_water), vnepogodin::Logger::queue_size);
+}
+
 void stop() {
     if (!hook_state)
         return;
-    hook_state         = false;
+    hook_state = false;
+#ifdef __linux__
+    if (running_backend == backend::evdev) {
+        evdev.stop();
+        close_logger();
+        return;
+    }
+#endif
     const auto& status = hook_stop();
-    logger.write();
-    logger.close();
+    close_logger();
 
     switch (status) {
     case UIOHOOK_ERROR_OUT_OF_MEMORY:
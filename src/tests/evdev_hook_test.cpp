@@ -0,0 +1,236 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include <vnepogodin/evdev_hook.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace vnepogodin;
+
+namespace {
+/* ctest's SKIP_RETURN_CODE, for machines without access to /dev/uinput */
+static constexpr int skipped = 77;
+
+static int failures = 0;
+
+#define CHECK(expr)                                                      \
+    do {                                                                 \
+        if (!(expr)) {                                                   \
+            std::fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #expr); \
+            ++failures;                                                  \
+        }                                                                \
+    } while (false)
+
+static std::vector<uiohook_event> events;
+static std::atomic<bool> enabled{};
+
+void collect(uiohook_event* const event) {
+    events.push_back(*event);
+    if (event->type == EVENT_HOOK_ENABLED) {
+        enabled.store(true, std::memory_order_release);
+    }
+}
+
+/* A virtual device, removed again when it goes out of scope */
+class uinput_device final {
+ public:
+    uinput_device() : m_fd(::open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC)) { }
+    uinput_device(const uinput_device&) = delete;
+    uinput_device& operator=(const uinput_device&) = delete;
+    ~uinput_device() {
+        if (m_fd >= 0) {
+            ::ioctl(m_fd, UI_DEV_DESTROY);
+            ::close(m_fd);
+        }
+    }
+
+    inline bool valid() const noexcept { return m_fd >= 0; }
+
+    void enable(const unsigned int& type, const std::vector<unsigned int>& codes) {
+        ::ioctl(m_fd, UI_SET_EVBIT, type);
+        const auto& request = (type == EV_KEY) ? UI_SET_KEYBIT : (type == EV_REL) ? UI_SET_RELBIT : UI_SET_ABSBIT;
+        for (const auto& code : codes) {
+            ::ioctl(m_fd, request, code);
+        }
+    }
+
+    void set_axis(const std::uint16_t& code, const std::int32_t& maximum) {
+        uinput_abs_setup setup{};
+        setup.code            = code;
+        setup.absinfo.minimum = 0;
+        setup.absinfo.maximum = maximum;
+        ::ioctl(m_fd, UI_ABS_SETUP, &setup);
+    }
+
+    /**
+     * @return the device node, empty if it didn't show up.
+     */
+    std::filesystem::path create(const char* name) {
+        uinput_setup setup{};
+        setup.id.bustype = BUS_VIRTUAL;
+        std::strncpy(setup.name, name, UINPUT_MAX_NAME_SIZE - 1);
+        if (::ioctl(m_fd, UI_DEV_SETUP, &setup) < 0 || ::ioctl(m_fd, UI_DEV_CREATE) < 0) {
+            return {};
+        }
+
+        std::array<char, 64> sysname{};
+        if (::ioctl(m_fd, UI_GET_SYSNAME(sysname.size()), sysname.data()) < 0) {
+            return {};
+        }
+
+        // udev creates the node shortly after the device appears in sysfs.
+        const auto& sys_path = std::filesystem::path("/sys/devices/virtual/input") / sysname.data();
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(sys_path, ec)) {
+                const auto& node = std::filesystem::path("/dev/input") / entry.path().filename();
+                if (entry.path().filename().string().starts_with("event") && std::filesystem::exists(node, ec)) {
+                    return node;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return {};
+    }
+
+    void emit(const std::uint16_t& type, const std::uint16_t& code, const std::int32_t& value) {
+        input_event event{};
+        event.type  = type;
+        event.code  = code;
+        event.value = value;
+        [[maybe_unused]] const auto& written = ::write(m_fd, &event, sizeof(event));
+    }
+
+    inline void sync() { emit(EV_SYN, SYN_REPORT, 0); }
+
+ private:
+    int m_fd{-1};
+};
+
+const uiohook_event* find(const event_type& type, std::size_t& from) {
+    for (; from < events.size(); ++from) {
+        if (events[from].type == type) {
+            return &events[from++];
+        }
+    }
+    return nullptr;
+}
+}  // namespace
+
+auto main() -> int {
+    uinput_device mouse;
+    uinput_device tablet;
+    if (!mouse.valid() || !tablet.valid()) {
+        std::puts("skipped, /dev/uinput isn't writable");
+        return skipped;
+    }
+
+    mouse.enable(EV_KEY, {KEY_A, BTN_LEFT, BTN_RIGHT});
+    mouse.enable(EV_REL, {REL_X, REL_Y, REL_WHEEL});
+    tablet.enable(EV_KEY, {BTN_TOUCH, BTN_TOOL_PEN});
+    tablet.enable(EV_ABS, {ABS_X, ABS_Y});
+    tablet.set_axis(ABS_X, 10000);
+    tablet.set_axis(ABS_Y, 5000);
+
+    const auto& mouse_node  = mouse.create("GOATTech test mouse");
+    const auto& tablet_node = tablet.create("GOATTech test tablet");
+    if (mouse_node.empty() || tablet_node.empty()) {
+        std::puts("skipped, the uinput devices got no readable node");
+        return skipped;
+    }
+
+    EvdevHook hook;
+    hook.set_bounds(0, 0, 1001, 501);
+    hook.set_devices({mouse_node, tablet_node});
+    std::thread runner([&hook] { hook.run(&collect); });
+    for (int attempt = 0; attempt < 100 && !enabled.load(std::memory_order_acquire); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    mouse.emit(EV_KEY, KEY_A, 1);
+    mouse.sync();
+    mouse.emit(EV_KEY, KEY_A, 0);
+    mouse.sync();
+    mouse.emit(EV_REL, REL_X, 10);
+    mouse.emit(EV_REL, REL_Y, -5);
+    mouse.sync();
+    mouse.emit(EV_KEY, BTN_LEFT, 1);
+    mouse.sync();
+    mouse.emit(EV_KEY, BTN_LEFT, 0);
+    mouse.sync();
+    mouse.emit(EV_REL, REL_WHEEL, 1);
+    mouse.sync();
+
+    // Tablets place the cursor, touching is a left click.
+    tablet.emit(EV_KEY, BTN_TOOL_PEN, 1);
+    tablet.emit(EV_KEY, BTN_TOUCH, 1);
+    tablet.emit(EV_ABS, ABS_X, 10000);
+    tablet.emit(EV_ABS, ABS_Y, 0);
+    tablet.sync();
+    tablet.emit(EV_KEY, BTN_TOUCH, 0);
+    tablet.sync();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    hook.stop();
+    runner.join();
+
+    std::size_t at = 0;
+    CHECK(find(EVENT_HOOK_ENABLED, at) != nullptr);
+    const auto* key_pressed  = find(EVENT_KEY_PRESSED, at);
+    const auto* key_released = find(EVENT_KEY_RELEASED, at);
+    CHECK(key_pressed != nullptr && key_pressed->data.keyboard.keycode == VC_A);
+    CHECK(key_released != nullptr && key_released->data.keyboard.keycode == VC_A);
+
+    const auto* moved = find(EVENT_MOUSE_MOVED, at);
+    CHECK(moved != nullptr && moved->data.mouse.x == 510 && moved->data.mouse.y == 245);
+
+    const auto* pressed  = find(EVENT_MOUSE_PRESSED, at);
+    const auto* released = find(EVENT_MOUSE_RELEASED, at);
+    const auto* clicked  = find(EVENT_MOUSE_CLICKED, at);
+    CHECK(pressed != nullptr && pressed->data.mouse.button == MOUSE_BUTTON1 && pressed->data.mouse.x == 510);
+    CHECK(released != nullptr && released->data.mouse.button == MOUSE_BUTTON1);
+    CHECK(clicked != nullptr && clicked->data.mouse.clicks == 1);
+
+    const auto* wheel = find(EVENT_MOUSE_WHEEL, at);
+    CHECK(wheel != nullptr && wheel->data.wheel.rotation == -1 && wheel->data.wheel.direction == WHEEL_VERTICAL_DIRECTION);
+
+    const auto* placed  = find(EVENT_MOUSE_MOVED, at);
+    const auto* touched = find(EVENT_MOUSE_PRESSED, at);
+    const auto* lifted  = find(EVENT_MOUSE_RELEASED, at);
+    CHECK(placed != nullptr && placed->data.mouse.x == 1000 && placed->data.mouse.y == 0);
+    CHECK(touched != nullptr && touched->data.mouse.button == MOUSE_BUTTON1 && touched->data.mouse.x == 1000);
+    CHECK(lifted != nullptr && lifted->data.mouse.button == MOUSE_BUTTON1);
+    CHECK(find(EVENT_HOOK_DISABLED, at) != nullptr);
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
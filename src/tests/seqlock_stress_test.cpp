@@ -0,0 +1,113 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include <vnepogodin/seqlock.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace vnepogodin;
+
+namespace {
+static constexpr std::size_t reader_count = 4;
+static constexpr std::chrono::seconds duration{2};
+
+/* Every word derives from seq, so any mix of two stores shows up */
+struct pattern {
+    std::uint64_t seq{};
+    std::array<std::uint64_t, 15> words{};
+    std::uint32_t tail{};
+
+    static pattern make(const std::uint64_t& seq) noexcept {
+        pattern result{};
+        result.seq = seq;
+        for (std::size_t i = 0; i < result.words.size(); ++i) {
+            result.words[i] = seq * 0x9E3779B97F4A7C15ULL + i;
+        }
+        result.tail = static_cast<std::uint32_t>(~seq);
+        return result;
+    }
+
+    bool consistent() const noexcept {
+        const auto& expected = make(seq);
+        return words == expected.words && tail == expected.tail;
+    }
+};
+
+struct reader_result {
+    std::uint64_t reads{};
+    std::uint64_t torn{};
+    std::uint64_t backwards{};
+};
+}  // namespace
+
+auto main() -> int {
+    seqlock<pattern> lock{pattern::make(0)};
+    std::atomic<bool> running{true};
+
+    std::vector<reader_result> results(reader_count);
+    std::vector<std::thread> readers;
+    for (auto& result : results) {
+        readers.emplace_back([&lock, &running, &result] {
+            std::uint64_t last = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                pattern value{};
+                if (!lock.try_load(value)) {
+                    continue;
+                }
+                ++result.reads;
+                result.torn += value.consistent() ? 0U : 1U;
+                result.backwards += (value.seq < last) ? 1U : 0U;
+                last = value.seq;
+            }
+        });
+    }
+
+    std::uint64_t seq = 0;
+    std::thread writer([&lock, &running, &seq] {
+        while (running.load(std::memory_order_relaxed)) {
+            lock.store(pattern::make(++seq));
+        }
+    });
+
+    std::this_thread::sleep_for(duration);
+    running.store(false, std::memory_order_relaxed);
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    int failures = 0;
+    for (const auto& result : results) {
+        std::printf("reads %llu, torn %llu, backwards %llu\n", static_cast<unsigned long long>(result.reads),
+            static_cast<unsigned long long>(result.torn), static_cast<unsigned long long>(result.backwards));
+        failures += (result.reads == 0 || result.torn != 0 || result.backwards != 0) ? 1 : 0;
+    }
+    std::printf("stores %llu, version %llu\n", static_cast<unsigned long long>(seq), static_cast<unsigned long long>(lock.version()));
+    if (lock.version() != seq + 1) {
+        ++failures;
+    }
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
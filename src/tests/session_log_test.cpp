@@ -0,0 +1,133 @@
+// Copyright (C) 2021 Vladislav Nepogodin
+//
+// This file is part of GOATTech project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include <vnepogodin/session_log.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace vnepogodin;
+
+namespace {
+static int failures = 0;
+
+#define CHECK(expr)                                                      \
+    do {                                                                 \
+        if (!(expr)) {                                                   \
+            std::fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #expr); \
+            ++failures;                                                  \
+        }                                                                \
+    } while (false)
+
+static constexpr std::int64_t base_time = 1700000000000000000;
+
+static std::vector<session_log::record> read_all(const std::filesystem::path& path) {
+    std::vector<session_log::record> result;
+    session_log::reader in(path);
+    session_log::reader::block block;
+    while (in.next(block)) {
+        const auto& records = block.records();
+        result.insert(result.end(), records.begin(), records.end());
+    }
+    return result;
+}
+
+static std::size_t index_entries(const std::filesystem::path& path) {
+    session_log::index_reader in(session_log::index_path(path));
+    session_log::index_entry entry{};
+    std::string name;
+    std::size_t count = 0;
+    while (in.next(entry, name)) {
+        ++count;
+    }
+    return count;
+}
+
+/* Appends the first half of a block, as a crash mid-flush leaves it */
+static void tear(const std::filesystem::path& path) {
+    session_log::block_header header{};
+    header.count     = 64;
+    header.base_time = base_time / 1000000;
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    session_log::detail::write_pod(out, header);
+    const std::vector<char> half(header.count * 4, '\x7f');
+    out.write(half.data(), static_cast<std::streamsize>(half.size()));
+}
+
+/* A block torn by a crash must not hide what is appended afterwards */
+static void append_after_torn_block(const bool& drop_index) {
+    const auto& dir  = std::filesystem::temp_directory_path() / "goattech_session_log_test";
+    const auto& path = dir / "keys.bin";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    session_log::writer out;
+    CHECK(out.open(path));
+    out.add(base_time, 1, EVENT_KEY_PRESSED);
+    out.add(base_time + 1500000, 1, EVENT_KEY_RELEASED);
+    CHECK(out.flush("first"));
+    CHECK(out.add_segment(base_time / 1000000, base_time / 1000000 + 2, 2, "first"));
+    out.close();
+
+    tear(path);
+    if (drop_index) {
+        std::filesystem::remove(session_log::index_path(path));
+    }
+
+    CHECK(out.open(path));
+    out.add(base_time + 5000000, 2, EVENT_KEY_PRESSED);
+    out.add(base_time + 5000001, 2, EVENT_KEY_RELEASED);
+    CHECK(out.flush("second"));
+    out.close();
+
+    const auto& records = read_all(path);
+    CHECK(records.size() == 4);
+    if (records.size() == 4) {
+        CHECK(records[0].time == base_time && records[0].key == 1);
+        CHECK(records[1].time == base_time + 1500000);
+        CHECK(records[2].time == base_time + 5000000 && records[2].key == 2);
+        CHECK(records[3].time == base_time + 5000001 && records[3].type == EVENT_KEY_RELEASED);
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<char> data(std::istreambuf_iterator<char>(in), {});
+    session_log::buffer_reader log(data.data(), data.size());
+    session_log::block_view block{};
+    session_log::segment_view segment{};
+    std::size_t chunks = 0;
+    while (log.next(block, segment) != session_log::chunk_type::none) {
+        ++chunks;
+    }
+    CHECK(chunks == 3);
+    CHECK(log.position() == data.size());
+    CHECK(index_entries(path) == 3);
+
+    std::filesystem::remove_all(dir);
+}
+}  // namespace
+
+auto main() -> int {
+    append_after_torn_block(false);
+    append_after_torn_block(true);
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,5 +0,0 @@
-set(CTEST_CUSTOM_COVERAGE_EXCLUDE
-  ".*examples.*"
-  ".*tests.*"
-  ".*benchmark.*"
-  ".*c[+][+].*")
@@ -1,40 +0,0 @@
-/*
- * Frozen
- * Copyright 2016 QuarksLab
- *
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *   http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing,
- * software distributed under the License is distributed on an
- * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
- * KIND, either express or implied.  See the License for the
- * specific language governing permissions and limitations
- * under the License.
- */
-
-#ifndef FROZEN_LETITGO_CONSTEXPR_ASSERT_H
-#define FROZEN_LETITGO_CONSTEXPR_ASSERT_H
-
-#include <cassert>
-
-#ifdef _MSC_VER
-
-// FIXME: find a way to implement that correctly for msvc
-#define constexpr_assert(cond, msg)
-
-#else
-
-#define constexpr_assert(cond, msg)\
-    assert(cond && msg);
-#endif
-
-#endif
-
@@ -21,6 +21,7 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /* Begin Error Codes */
@@ -130,6 +131,16 @@ typedef void (*dispatcher_t)(uiohook_event *const);
 /* End Virtual Event Types and Data Structures */
 
 
+/* Begin Event Subscription Masks */
+#define EVENT_MASK(type)                         (1U << (type))
+#define EVENT_MASK_ALL                           0xFFFFFFFFU
+
+#define EVENT_MASK_KEYBOARD                      (EVENT_MASK(EVENT_KEY_TYPED) | EVENT_MASK(EVENT_KEY_PRESSED) | EVENT_MASK(EVENT_KEY_RELEASED))
+#define EVENT_MASK_MOUSE_BUTTONS                 (EVENT_MASK(EVENT_MOUSE_CLICKED) | EVENT_MASK(EVENT_MOUSE_PRESSED) | EVENT_MASK(EVENT_MOUSE_RELEASED) | EVENT_MASK(EVENT_MOUSE_WHEEL))
+#define EVENT_MASK_MOUSE_MOTION                  (EVENT_MASK(EVENT_MOUSE_MOVED) | EVENT_MASK(EVENT_MOUSE_DRAGGED))
+/* End Event Subscription Masks */
+
+
 /* Begin Virtual Key Codes */
 #define VC_ESCAPE                                0x0001
 
@@ -423,6 +434,16 @@ extern "C" {
     // Set the event callback function.
     UIOHOOK_API void hook_set_dispatch_proc(dispatcher_t dispatch_proc);
 
+    // Set the event types delivered to the dispatcher, a combination of
+    // EVENT_MASK(type).  Hook enabled and disabled events are always delivered.
+    // Must be called before hook_run(), X11 stops recording what is left out.
+    UIOHOOK_API void hook_set_event_mask(uint32_t mask);
+
+    // Only look up the keysym (rawcode) of these virtual keycodes, NULL or an
+    // empty list translates every key.  Presses and releases of other keys are
+    // still delivered, with a rawcode of 0 on X11.  Must be called before hook_run().
+    UIOHOOK_API void hook_set_keycode_filter(const uint16_t *keycodes, size_t count);
+
     // Insert the event hook.
     UIOHOOK_API int hook_run();
 
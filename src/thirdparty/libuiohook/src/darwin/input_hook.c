@@ -31,6 +31,7 @@
 
 #include "input_helper.h"
 #include "logger.h"
+#include "subscription.h"
 
 typedef struct _hook_info {
     CFMachPortRef port;
@@ -99,7 +100,10 @@ UIOHOOK_API void hook_set_dispatch_proc(dispatcher_t dispatch_proc) {
 
 // Send out an event if a dispatcher was set.
 static inline void dispatch_event(uiohook_event *const event) {
-    if (dispatcher != NULL) {
+    if (!is_subscribed(event)) {
+        logger(LOG_LEVEL_DEBUG, "%s [%u]: Skipping unsubscribed event type %u.\n",
+                __FUNCTION__, __LINE__, event->type);
+    } else if (dispatcher != NULL) {
         logger(LOG_LEVEL_DEBUG, "%s [%u]: Dispatching event type %u.\n",
                 __FUNCTION__, __LINE__, event->type);
 
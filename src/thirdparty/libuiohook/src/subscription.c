@@ -0,0 +1,74 @@
+/* libUIOHook: Cross-platform keyboard and mouse hooking from userland.
+ * Copyright (C) 2006-2020 Alexander Barker.  All Rights Received.
+ * https://github.com/kwhat/libuiohook/
+ *
+ * libUIOHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libUIOHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <uiohook.h>
+
+#include "logger.h"
+#include "subscription.h"
+
+// Event types delivered to the dispatcher.
+static uint32_t event_mask = EVENT_MASK_ALL;
+
+// One bit per virtual keycode, only used while keycode_filter is set.
+static bool keycode_filter = false;
+static uint8_t keycodes[(UINT16_MAX + 1) / CHAR_BIT];
+
+UIOHOOK_API void hook_set_event_mask(uint32_t mask) {
+    logger(LOG_LEVEL_DEBUG, "%s [%u]: Setting event mask to %#X.\n",
+            __FUNCTION__, __LINE__, mask);
+
+    event_mask = mask;
+}
+
+UIOHOOK_API void hook_set_keycode_filter(const uint16_t *filter, size_t count) {
+    memset(keycodes, 0x00, sizeof(keycodes));
+    keycode_filter = filter != NULL && count > 0;
+
+    for (size_t i = 0; keycode_filter && i < count; i++) {
+        keycodes[filter[i] / CHAR_BIT] |= (uint8_t) (1 << (filter[i] % CHAR_BIT));
+    }
+
+    logger(LOG_LEVEL_DEBUG, "%s [%u]: Translating %s keys.\n",
+            __FUNCTION__, __LINE__, keycode_filter ? "filtered" : "all");
+}
+
+uint32_t get_event_mask() {
+    return event_mask;
+}
+
+bool is_event_subscribed(event_type type) {
+    // The hook's own lifecycle can't be unsubscribed.
+    if (type == EVENT_HOOK_ENABLED || type == EVENT_HOOK_DISABLED) {
+        return true;
+    }
+
+    return (event_mask & EVENT_MASK(type)) != 0;
+}
+
+bool is_keycode_subscribed(uint16_t keycode) {
+    return !keycode_filter || (keycodes[keycode / CHAR_BIT] & (1 << (keycode % CHAR_BIT))) != 0;
+}
+
+bool is_subscribed(const uiohook_event *const event) {
+    // The keycode filter only saves translation, every key is still delivered.
+    return is_event_subscribed(event->type);
+}
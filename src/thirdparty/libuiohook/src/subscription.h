@@ -0,0 +1,38 @@
+/* libUIOHook: Cross-platform keyboard and mouse hooking from userland.
+ * Copyright (C) 2006-2020 Alexander Barker.  All Rights Received.
+ * https://github.com/kwhat/libuiohook/
+ *
+ * libUIOHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libUIOHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _included_subscription
+#define _included_subscription
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+// Event types set by hook_set_event_mask().
+extern uint32_t get_event_mask();
+
+// Check if anyone listens to this event type.
+extern bool is_event_subscribed(event_type type);
+
+// Check if key events with this virtual keycode need their keysym.
+extern bool is_keycode_subscribed(uint16_t keycode);
+
+// Check if anyone listens to this event, for the platforms that can only filter at dispatch.
+extern bool is_subscribed(const uiohook_event *const event);
+
+#endif
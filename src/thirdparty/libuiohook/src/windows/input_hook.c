@@ -22,6 +22,7 @@
 
 #include "input_helper.h"
 #include "logger.h"
+#include "subscription.h"
 
 // Thread and hook handles.
 static DWORD hook_thread_id = 0;
@@ -55,7 +56,10 @@ UIOHOOK_API void hook_set_dispatch_proc(dispatcher_t dispatch_proc) {
 
 // Send out an event if a dispatcher was set.
 static inline void dispatch_event(uiohook_event *const event) {
-    if (dispatcher != NULL) {
+    if (!is_subscribed(event)) {
+        logger(LOG_LEVEL_DEBUG, "%s [%u]: Skipping unsubscribed event type %u.\n",
+                __FUNCTION__, __LINE__, event->type);
+    } else if (dispatcher != NULL) {
         logger(LOG_LEVEL_DEBUG, "%s [%u]: Dispatching event type %u.\n",
                 __FUNCTION__, __LINE__, event->type);
 
@@ -45,6 +45,7 @@
 #endif
 
 #include "logger.h"
+#include "subscription.h"
 #include "input_helper.h"
 
 // Thread and hook handles.
@@ -58,7 +59,8 @@ static pthread_mutex_t hook_xrecord_mutex = PTHREAD_MUTEX_INITIALIZER;
 typedef struct _hook_info {
     struct _data {
         Display *display;
-        XRecordRange *range;
+        XRecordRange *range[3];
+        int range_count;
     } data;
     struct _ctrl {
         Display *display;
@@ -111,7 +113,10 @@ UIOHOOK_API void hook_set_dispatch_proc(dispatcher_t dispatch_proc) {
 
 // Send out an event if a dispatcher was set.
 static inline void dispatch_event(uiohook_event *const event) {
-    if (dispatcher != NULL) {
+    if (!is_subscribed(event)) {
+        logger(LOG_LEVEL_DEBUG, "%s [%u]: Skipping unsubscribed event type %u.\n",
+                __FUNCTION__, __LINE__, event->type);
+    } else if (dispatcher != NULL) {
         logger(LOG_LEVEL_DEBUG, "%s [%u]: Dispatching event type %u.\n",
                 __FUNCTION__, __LINE__, event->type);
 
@@ -281,29 +286,40 @@ void hook_event_proc(XPointer closeure, XRecordInterceptData *recorded_data) {
         if (data->type == KeyPress) {
             // The X11 KeyCode associated with this event.
             KeyCode keycode = (KeyCode) data->event.u.u.detail;
+            unsigned short int scancode = keycode_to_scancode(keycode);
+
+            // Only translate keys someone asked for, keypad keys may still
+            // turn into their num lock variant below.
+            bool is_pressed_wanted = is_event_subscribed(EVENT_KEY_PRESSED);
+            bool is_typed_wanted = is_event_subscribed(EVENT_KEY_TYPED);
+            bool is_keysym_wanted = is_typed_wanted || (is_pressed_wanted
+                    && (is_keycode_subscribed(scancode) || is_keycode_subscribed(scancode | 0xEE00)));
+
             KeySym keysym = 0x00;
-            #if defined(USE_XKB_COMMON)
-            if (state != NULL) {
-                keysym = xkb_state_key_get_one_sym(state, keycode);
+            if (is_keysym_wanted) {
+                #if defined(USE_XKB_COMMON)
+                if (state != NULL) {
+                    keysym = xkb_state_key_get_one_sym(state, keycode);
+                }
+                #else
+                keysym = keycode_to_keysym(keycode, data->event.u.keyButtonPointer.state);
+                #endif
             }
-            #else
-            keysym = keycode_to_keysym(keycode, data->event.u.keyButtonPointer.state);
-            #endif
 
             // Check to make sure the key is printable.
             uint16_t buffer[2];
             size_t count =  0;
-            #ifdef USE_XKB_COMMON
-            if (state != NULL) {
-                count = keycode_to_unicode(state, keycode, buffer, sizeof(buffer) / sizeof(uint16_t));
+            if (is_typed_wanted) {
+                #ifdef USE_XKB_COMMON
+                if (state != NULL) {
+                    count = keycode_to_unicode(state, keycode, buffer, sizeof(buffer) / sizeof(uint16_t));
+                }
+                #else
+                count = keysym_to_unicode(keysym, buffer, sizeof(buffer) / sizeof(uint16_t));
+                #endif
             }
-            #else
-            count = keysym_to_unicode(keysym, buffer, sizeof(buffer) / sizeof(uint16_t));
-            #endif
 
 
-            unsigned short int scancode = keycode_to_scancode(keycode);
-
             // TODO If you have a better suggestion for this ugly, let me know.
             if      (scancode == VC_SHIFT_L)   { set_modifier_mask(MASK_SHIFT_L); }
             else if (scancode == VC_SHIFT_R)   { set_modifier_mask(MASK_SHIFT_R); }
@@ -341,18 +357,20 @@ void hook_event_proc(XPointer closeure, XRecordInterceptData *recorded_data) {
             event.time = timestamp;
             event.reserved = 0x00;
 
-            event.type = EVENT_KEY_PRESSED;
-            event.mask = get_modifiers();
+            if (is_pressed_wanted) {
+                event.type = EVENT_KEY_PRESSED;
+                event.mask = get_modifiers();
 
-            event.data.keyboard.keycode = scancode;
-            event.data.keyboard.rawcode = keysym;
-            event.data.keyboard.keychar = CHAR_UNDEFINED;
+                event.data.keyboard.keycode = scancode;
+                event.data.keyboard.rawcode = keysym;
+                event.data.keyboard.keychar = CHAR_UNDEFINED;
 
-            logger(LOG_LEVEL_DEBUG, "%s [%u]: Key %#X pressed. (%#X)\n",
-                    __FUNCTION__, __LINE__, event.data.keyboard.keycode, event.data.keyboard.rawcode);
+                logger(LOG_LEVEL_DEBUG, "%s [%u]: Key %#X pressed. (%#X)\n",
+                        __FUNCTION__, __LINE__, event.data.keyboard.keycode, event.data.keyboard.rawcode);
 
-            // Fire key pressed event.
-            dispatch_event(&event);
+                // Fire key pressed event.
+                dispatch_event(&event);
+            }
 
             // If the pressed event was not consumed...
             if (event.reserved ^ 0x01) {
@@ -378,26 +396,22 @@ void hook_event_proc(XPointer closeure, XRecordInterceptData *recorded_data) {
         } else if (data->type == KeyRelease) {
             // The X11 KeyCode associated with this event.
             KeyCode keycode = (KeyCode) data->event.u.u.detail;
-            KeySym keysym = 0x00;
-            #ifdef USE_XKB_COMMON
-            if (state != NULL) {
-                keysym = xkb_state_key_get_one_sym(state, keycode);
-            }
-            #else
-            keysym = keycode_to_keysym(keycode, data->event.u.keyButtonPointer.state);
-            #endif
+            unsigned short int scancode = keycode_to_scancode(keycode);
 
-            // Check to make sure the key is printable.
-            uint16_t buffer[2];
-            #ifdef USE_XKB_COMMON
-            if (state != NULL) {
-                keycode_to_unicode(state, keycode, buffer, sizeof(buffer) / sizeof(uint16_t));
-            }
-            #else
-            keysym_to_unicode(keysym, buffer, sizeof(buffer) / sizeof(uint16_t));
-            #endif
+            bool is_released_wanted = is_event_subscribed(EVENT_KEY_RELEASED);
+            bool is_keysym_wanted = is_released_wanted
+                    && (is_keycode_subscribed(scancode) || is_keycode_subscribed(scancode | 0xEE00));
 
-            unsigned short int scancode = keycode_to_scancode(keycode);
+            KeySym keysym = 0x00;
+            if (is_keysym_wanted) {
+                #ifdef USE_XKB_COMMON
+                if (state != NULL) {
+                    keysym = xkb_state_key_get_one_sym(state, keycode);
+                }
+                #else
+                keysym = keycode_to_keysym(keycode, data->event.u.keyButtonPointer.state);
+                #endif
+            }
 
             // TODO If you have a better suggestion for this ugly, let me know.
             if        (scancode == VC_SHIFT_L) { unset_modifier_mask(MASK_SHIFT_L); }
@@ -431,22 +445,24 @@ void hook_event_proc(XPointer closeure, XRecordInterceptData *recorded_data) {
                 }
             }
 
-            // Populate key released event.
-            event.time = timestamp;
-            event.reserved = 0x00;
+            if (is_released_wanted) {
+                // Populate key released event.
+                event.time = timestamp;
+                event.reserved = 0x00;
 
-            event.type = EVENT_KEY_RELEASED;
-            event.mask = get_modifiers();
+                event.type = EVENT_KEY_RELEASED;
+                event.mask = get_modifiers();
 
-            event.data.keyboard.keycode = scancode;
-            event.data.keyboard.rawcode = keysym;
-            event.data.keyboard.keychar = CHAR_UNDEFINED;
+                event.data.keyboard.keycode = scancode;
+                event.data.keyboard.rawcode = keysym;
+                event.data.keyboard.keychar = CHAR_UNDEFINED;
 
-            logger(LOG_LEVEL_DEBUG, "%s [%u]: Key %#X released. (%#X)\n",
-                    __FUNCTION__, __LINE__, event.data.keyboard.keycode, event.data.keyboard.rawcode);
+                logger(LOG_LEVEL_DEBUG, "%s [%u]: Key %#X released. (%#X)\n",
+                        __FUNCTION__, __LINE__, event.data.keyboard.keycode, event.data.keyboard.rawcode);
 
-            // Fire key released event.
-            dispatch_event(&event);
+                // Fire key released event.
+                dispatch_event(&event);
+            }
         } else if (data->type == ButtonPress) {
             // X11 handles wheel events as button events.
             if (data->event.u.u.detail == WheelUp || data->event.u.u.detail == WheelDown
@@ -872,6 +888,64 @@ static inline int xrecord_block() {
     return status;
 }
 
+// Allocate one XRecord range per run of X11 events the subscribed types need.
+static bool xrecord_alloc_ranges() {
+    uint32_t mask = get_event_mask();
+
+    bool is_recorded[MotionNotify + 1] = { false };
+    if (mask & EVENT_MASK_KEYBOARD) {
+        // Releases are needed to track modifiers, even if only presses are delivered.
+        is_recorded[KeyPress] = is_recorded[KeyRelease] = true;
+    }
+    if (mask & (EVENT_MASK_MOUSE_BUTTONS | EVENT_MASK(EVENT_MOUSE_DRAGGED))) {
+        // Dragging is told apart from moving by the button mask.
+        is_recorded[ButtonPress] = is_recorded[ButtonRelease] = true;
+    }
+    if (mask & EVENT_MASK_MOUSE_MOTION) {
+        is_recorded[MotionNotify] = true;
+    }
+
+    hook->data.range_count = 0;
+    for (int type = KeyPress; type <= MotionNotify; type++) {
+        if (!is_recorded[type]) {
+            continue;
+        }
+
+        if (hook->data.range_count > 0 && hook->data.range[hook->data.range_count - 1]->device_events.last == type - 1) {
+            hook->data.range[hook->data.range_count - 1]->device_events.last = type;
+            continue;
+        }
+
+        XRecordRange *range = XRecordAllocRange();
+        if (range == NULL) {
+            return false;
+        }
+        range->device_events.first = type;
+        range->device_events.last = type;
+        hook->data.range[hook->data.range_count++] = range;
+    }
+
+    // XRecord needs at least one range to create a context.
+    if (hook->data.range_count == 0) {
+        XRecordRange *range = XRecordAllocRange();
+        if (range == NULL) {
+            return false;
+        }
+        range->device_events.first = KeyPress;
+        range->device_events.last = MotionNotify;
+        hook->data.range[hook->data.range_count++] = range;
+    }
+
+    return true;
+}
+
+static void xrecord_free_ranges() {
+    for (int i = 0; i < hook->data.range_count; i++) {
+        XFree(hook->data.range[i]);
+    }
+    hook->data.range_count = 0;
+}
+
 static int xrecord_alloc() {
     int status = UIOHOOK_FAILURE;
 
@@ -883,18 +957,14 @@ static int xrecord_alloc() {
     // Setup XRecord range.
     XRecordClientSpec clients = XRecordAllClients;
 
-    hook->data.range = XRecordAllocRange();
-    if (hook->data.range != NULL) {
-        logger(LOG_LEVEL_DEBUG, "%s [%u]: XRecordAllocRange successful.\n",
-                __FUNCTION__, __LINE__);
-
-        hook->data.range->device_events.first = KeyPress;
-        hook->data.range->device_events.last = MotionNotify;
+    if (xrecord_alloc_ranges()) {
+        logger(LOG_LEVEL_DEBUG, "%s [%u]: XRecordAllocRange successful. (%d ranges)\n",
+                __FUNCTION__, __LINE__, hook->data.range_count);
 
         // Note that the documentation for this function is incorrect,
         // hook->data.display should be used!
         // See: http://www.x.org/releases/X11R7.6/doc/libXtst/recordlib.txt
-        hook->ctrl.context = XRecordCreateContext(hook->data.display, XRecordFromServerTime, &clients, 1, &hook->data.range, 1);
+        hook->ctrl.context = XRecordCreateContext(hook->data.display, XRecordFromServerTime, &clients, 1, hook->data.range, hook->data.range_count);
         if (hook->ctrl.context != 0) {
             logger(LOG_LEVEL_DEBUG, "%s [%u]: XRecordCreateContext successful.\n",
                     __FUNCTION__, __LINE__);
@@ -912,12 +982,15 @@ static int xrecord_alloc() {
             status = UIOHOOK_ERROR_X_RECORD_CREATE_CONTEXT;
         }
 
-        // Free the XRecord range.
-        XFree(hook->data.range);
+        // Free the XRecord ranges.
+        xrecord_free_ranges();
     } else {
         logger(LOG_LEVEL_ERROR, "%s [%u]: XRecordAllocRange failure!\n",
                 __FUNCTION__, __LINE__);
 
+        // Free what was allocated before the failure.
+        xrecord_free_ranges();
+
         // Set the exit status.
         status = UIOHOOK_ERROR_X_RECORD_ALLOC_RANGE;
     }
@@ -1035,6 +1108,7 @@ UIOHOOK_API int hook_run() {
     hook = malloc(sizeof(hook_info));
     if (hook != NULL) {
         hook->input.mask = 0x0000;
+        hook->data.range_count = 0;
         hook->input.mouse.is_dragged = false;
         hook->input.mouse.click.count = 0;
         hook->input.mouse.click.time = 0;